@@ -0,0 +1,228 @@
+/**
+ * @file BasicSlewRateLimiter.h
+ * @brief SlewRateLimiter templated on the sample type.
+ *
+ * SlewRateLimiter works in int, which is 16 bits on AVR and 32 bits on most hosts, so its range and its
+ * overflow behaviour depend on the platform. BasicSlewRateLimiter<T> runs the same algorithm on an explicit
+ * sample type, with every intermediate value (delta, allowed change, EMA update) computed in a wider type:
+ *
+ * - Integer types (int8_t ... int64_t, and int/long on any platform): the wide type is the accumulator of
+ *   SRL_WideEMA, 32 bits for 8- and 16-bit samples and 64 bits for 32-bit samples, so ema * 1024 and
+ *   |delta| * slope fit even where int is 16 bits. 64-bit samples also get 64 bits and must stay well inside
+ *   +-2^52. In the range where SlewRateLimiter does not overflow, BasicSlewRateLimiter<int> is bit-exact with
+ *   it; outside that range it keeps working where SlewRateLimiter overflows.
+ * - SRL_Q15: Q15 fixed point (-1.0 .. 1.0 in 16 bits), computed in 32 bits and saturated back to 16 bits.
+ *   Rates and bands are given in Q15 LSBs.
+ * - float and double: the same EMA, rate limit, adaptive slope and hysteresis in floating point, for example
+ *   for audio-rate parameter smoothing. The EMA weight is 2^exponent / 1024 and the adaptive slope adds
+ *   |delta| * slope / 100, as in the integer versions, but without truncation.
+ *
+ * The enums, the method names and the EMA modes are those of SlewRateLimiter. Rates, bands and the internal
+ * slope are stored in the wide type.
+ *
+ * Header-only: there is nothing to compile in the library for this template.
+ */
+
+#ifndef BasicSlewRateLimiter_h
+#define BasicSlewRateLimiter_h
+
+#include "SlewRateLimiter.h"
+
+/**
+ * Q15 fixed-point sample: raw / 32768, saturating at -1.0 and 32767 / 32768.
+ */
+struct SRL_Q15
+{
+    int16_t raw;
+
+    static SRL_Q15 fromRaw(int16_t value) { SRL_Q15 q; q.raw = value; return q; }
+    static SRL_Q15 fromFloat(float value)
+    {
+      float scaled = value * 32768.0f;
+      return fromRaw(scaled >= 32767.0f ? 32767 : scaled <= -32768.0f ? -32768 : (int16_t)scaled);
+    }
+    float toFloat() const { return raw / 32768.0f; }
+
+    bool operator==(const SRL_Q15& other) const { return raw == other.raw; }
+    bool operator!=(const SRL_Q15& other) const { return raw != other.raw; }
+};
+
+/**
+ * Integer sample traits: the wide type is the SRL_WideEMA accumulator of the sample width, the EMA and the
+ * adaptive slope use the same shifts as SlewRateLimiter.
+ */
+template <typename T>
+struct SRL_IntegerSampleTraits
+{
+    typedef typename SRL_WideAccumulator<sizeof(T)>::type Wide;
+
+    static inline Wide toWide(T value) { return value; }
+    static inline T fromWide(Wide value) { return (T)value; }
+    static inline Wide absValue(Wide value) { return value < 0 ? -value : value; }
+
+    static inline Wide updateEMA(Wide newValue, Wide currentEMA, int exponent)
+    {
+      Wide scale = (Wide)1 << exponent;
+      return (newValue * scale + currentEMA * 1024 - currentEMA * scale) >> 10;
+    }
+
+    static inline Wide slopeToInternal(int slope) { return ((Wide)slope * 128 + 50) / 100; }
+    static inline Wide adaptiveChange(Wide absDelta, Wide slopeInternal) { return (absDelta * slopeInternal) >> 7; }
+};
+
+/**
+ * Floating-point sample traits: the same operations without truncation.
+ */
+template <typename T>
+struct SRL_FloatSampleTraits
+{
+    typedef T Wide;
+
+    static inline Wide toWide(T value) { return value; }
+    static inline T fromWide(Wide value) { return value; }
+    static inline Wide absValue(Wide value) { return value < 0 ? -value : value; }
+
+    static inline Wide updateEMA(Wide newValue, Wide currentEMA, int exponent)
+    {
+      return currentEMA + (newValue - currentEMA) * ((T)(1 << exponent) / (T)1024);
+    }
+
+    static inline Wide slopeToInternal(int slope) { return (T)slope * (T)128 / (T)100; }
+    static inline Wide adaptiveChange(Wide absDelta, Wide slopeInternal) { return absDelta * slopeInternal / (T)128; }
+};
+
+template <typename T> struct SRL_SampleTraits;
+template <> struct SRL_SampleTraits<signed char> : SRL_IntegerSampleTraits<signed char> {};
+template <> struct SRL_SampleTraits<short> : SRL_IntegerSampleTraits<short> {};
+template <> struct SRL_SampleTraits<int> : SRL_IntegerSampleTraits<int> {};
+template <> struct SRL_SampleTraits<long> : SRL_IntegerSampleTraits<long> {};
+template <> struct SRL_SampleTraits<long long> : SRL_IntegerSampleTraits<long long> {};
+template <> struct SRL_SampleTraits<float> : SRL_FloatSampleTraits<float> {};
+template <> struct SRL_SampleTraits<double> : SRL_FloatSampleTraits<double> {};
+
+template <>
+struct SRL_SampleTraits<SRL_Q15> : SRL_IntegerSampleTraits<int16_t>
+{
+    static inline Wide toWide(SRL_Q15 value) { return value.raw; }
+    static inline SRL_Q15 fromWide(Wide value)
+    {
+      return SRL_Q15::fromRaw(value > 32767 ? 32767 : value < -32768 ? -32768 : (int16_t)value);
+    }
+};
+
+template <typename T>
+class BasicSlewRateLimiter 
+{
+public:
+    typedef SRL_SampleTraits<T> Traits;
+    typedef typename Traits::Wide Wide;
+
+    BasicSlewRateLimiter(
+        SlewRateLimiter::SRL_SmoothingExponent exponent = SlewRateLimiter::SRL_SMOOTHING_4, 
+        Wide rate = 5, 
+        Wide hystBand = 2,
+        int slope = 0,
+        SlewRateLimiter::SRL_EMAMode mode = SlewRateLimiter::SRL_EMA_TRACK
+    )
+      : lastValue(Traits::fromWide(0)),
+        emaValue(Traits::fromWide(0)),
+        isFirstCall(true),
+        emaMode(mode),
+        currentExponent(exponent),
+        rateLimit(rate),
+        hysteresisBand(hystBand),
+        adaptiveSlopeInternal(Traits::slopeToInternal(slope))
+    {
+    }
+
+    T processValue(T currentValue)
+    {
+      if (isFirstCall)
+      {
+        lastValue = currentValue;
+        emaValue = currentValue;
+        isFirstCall = false;
+        return currentValue;
+      }
+
+      Wide target = Traits::toWide(currentValue);
+      if (emaMode != SlewRateLimiter::SRL_EMA_OFF)
+      {
+        Wide ema = Traits::updateEMA(target, Traits::toWide(emaValue), currentExponent);
+        emaValue = Traits::fromWide(ema);
+
+        // In drive mode the smoothed signal is limited instead of the raw input
+        if (emaMode == SlewRateLimiter::SRL_EMA_DRIVE)
+        {
+          target = ema;
+        }
+      }
+
+      Wide last = Traits::toWide(lastValue);
+      Wide delta = target - last;
+      Wide allowedChange = rateLimit;
+
+      // Implement adaptive slope if applicable
+      if (adaptiveSlopeInternal != 0)
+      {
+        allowedChange += Traits::adaptiveChange(Traits::absValue(delta), adaptiveSlopeInternal);
+      }
+
+      // Rate limiting
+      if (delta > allowedChange)
+      {
+        last += allowedChange;
+      }
+      else if (delta < -allowedChange)
+      {
+        last -= allowedChange;
+      }
+      else
+      {
+        last = target;
+      }
+
+      // Apply hysteresis
+      if (Traits::absValue(target - last) <= hysteresisBand)
+      {
+        last = target;
+      }
+
+      lastValue = Traits::fromWide(last);
+      return lastValue;
+    }
+
+    void processBlock(const T* in, T* out, size_t n)
+    {
+      for (size_t i = 0; i < n; i++)
+      {
+        out[i] = processValue(in[i]);
+      }
+    }
+
+    void setRateLimit(Wide limit) { rateLimit = limit; }
+    void setHysteresisBand(Wide band) { hysteresisBand = band; }
+    void setSmoothingExponent(SlewRateLimiter::SRL_SmoothingExponent exponent) { currentExponent = exponent; }
+    void setAdaptiveSlope(int slope) { adaptiveSlopeInternal = Traits::slopeToInternal(slope); }
+    void setEMAMode(SlewRateLimiter::SRL_EMAMode mode) { emaMode = mode; }
+    T getEMA() const { return emaValue; }
+
+    void reset()
+    {
+      isFirstCall = true;
+      lastValue = Traits::fromWide(0);
+      emaValue = Traits::fromWide(0);
+    }
+
+private:
+    T lastValue;
+    T emaValue;
+    bool isFirstCall;
+    SlewRateLimiter::SRL_EMAMode emaMode;
+    SlewRateLimiter::SRL_SmoothingExponent currentExponent;
+    Wide rateLimit;
+    Wide hysteresisBand;
+    Wide adaptiveSlopeInternal;
+};
+
+#endif /* BasicSlewRateLimiter_h */
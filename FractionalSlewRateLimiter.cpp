@@ -0,0 +1,173 @@
+/**
+ * @file FractionalSlewRateLimiter.cpp
+ * @brief Implements the FractionalSlewRateLimiter class, a slew rate limiter with Q16.16 state.
+ *
+ * Every sample, the distance to the target is taken as an unsigned Q16.16 value (it can reach 65535 units,
+ * which does not fit in a signed Q16.16 long). The step towards the target is the distance, capped first by
+ * the rate limit and then by the adaptive term, so the sum of the two never overflows. What is left of the
+ * distance after the step is compared with the hysteresis band.
+ *
+ * Methods:
+ * - processValue: Applies rate limiting to an input value based on the current configuration.
+ * - setRateLimit, setRateLimitFraction, setRateLimitQ16: Configure the rate limit in whole units, as a
+ *   fraction, or as a raw Q16.16 value.
+ * - getRateLimitQ16, getValueQ16: Return the rate limit and the last output value in Q16.16.
+ * - setHysteresisBand, setSmoothingExponent, setAdaptiveSlope, setEMAMode: As SlewRateLimiter.
+ * - getEMA: Returns the current EMA value.
+ * - reset: Reinitializes the internal state, clearing the EMA and last output value.
+ */
+
+
+#include "FractionalSlewRateLimiter.h"
+
+// Largest value of the Q16.16 state, the rate limit and the distance to the target: 65535 units
+static const uint32_t SRL_Q16_MAX_DISTANCE = 0xFFFF0000UL;
+
+FractionalSlewRateLimiter::FractionalSlewRateLimiter(
+    SlewRateLimiter::SRL_SmoothingExponent exponent, 
+    int rate, 
+    int hystBand, 
+    int slope,
+    SlewRateLimiter::SRL_EMAMode mode
+)
+  : lastValueQ16(0),
+    emaValue(0),
+    isFirstCall(true),
+    emaMode(mode),
+    currentExponent(exponent),
+    rateLimitQ16(0),
+    hysteresisBandQ16(0),
+    adaptiveSlopeInternal(0)
+{
+  setRateLimit(rate);
+  setHysteresisBand(hystBand);
+  setAdaptiveSlope(slope);
+}
+
+int FractionalSlewRateLimiter::processValue(int currentValue)
+{
+  if (isFirstCall)
+  {
+    lastValueQ16 = (int32_t)currentValue * 65536;
+    emaValue = currentValue;
+    isFirstCall = false;
+    return currentValue;
+  }
+
+  int32_t target = currentValue;
+  if (emaMode != SlewRateLimiter::SRL_EMA_OFF)
+  {
+    // Same EMA as SlewRateLimiter, in 32 bits
+    int32_t scale = (int32_t)1 << currentExponent;
+    emaValue = ((int32_t)currentValue * scale + emaValue * 1024 - emaValue * scale) >> 10;
+
+    // In drive mode the smoothed signal is limited instead of the raw input
+    if (emaMode == SlewRateLimiter::SRL_EMA_DRIVE)
+    {
+      target = emaValue;
+    }
+  }
+
+  int32_t targetQ16 = target * 65536;
+  bool rising = targetQ16 > lastValueQ16;
+  uint32_t distance = rising ? (uint32_t)targetQ16 - (uint32_t)lastValueQ16
+                             : (uint32_t)lastValueQ16 - (uint32_t)targetQ16;
+
+  // Adaptive term on the whole-unit distance; capped at 65535 units, which reaches any target
+  uint32_t adaptive = ((distance >> 16) * (uint32_t)adaptiveSlopeInternal) >> 7;
+  adaptive = (adaptive > 0xFFFF) ? SRL_Q16_MAX_DISTANCE : adaptive << 16;
+
+  // Rate limiting: step by the rate limit, then by the adaptive term, never past the target
+  uint32_t step = (distance < rateLimitQ16) ? distance : rateLimitQ16;
+  uint32_t remaining = distance - step;
+  step += (remaining < adaptive) ? remaining : adaptive;
+  remaining = distance - step;
+
+  // Apply hysteresis (also snaps exactly onto the target once it is reached)
+  uint32_t moved = rising ? (uint32_t)lastValueQ16 + step : (uint32_t)lastValueQ16 - step;
+  lastValueQ16 = (remaining <= hysteresisBandQ16) ? targetQ16 : (int32_t)moved;
+
+  // Round to the nearest integer
+  return (int)((lastValueQ16 + 0x8000) >> 16);
+}
+
+void FractionalSlewRateLimiter::setRateLimit(int limit) 
+{
+    rateLimitQ16 = (limit <= 0) ? 0 : ((unsigned long)limit > 0xFFFFUL) ? SRL_Q16_MAX_DISTANCE : (uint32_t)limit << 16;
+}
+
+void FractionalSlewRateLimiter::setRateLimitFraction(long numerator, long denominator) 
+{
+    if (numerator <= 0 || denominator <= 0)
+    {
+      rateLimitQ16 = 0;
+      return;
+    }
+    uint32_t whole = (uint32_t)(numerator / denominator);
+    // floor(remainder * 65536 / denominator) by binary long division: remainder * 65536 does not fit in 32 bits
+    // once the denominator is above 65536, and the remainder stays below the denominator (< 2^31), so doubling
+    // it never overflows. This also keeps 64-bit arithmetic off AVR.
+    uint32_t remainder = (uint32_t)(numerator % denominator);
+    uint32_t fraction = 0;
+    for (int bit = 0; bit < 16; bit++)
+    {
+      remainder <<= 1;
+      fraction <<= 1;
+      if (remainder >= (uint32_t)denominator)
+      {
+        remainder -= (uint32_t)denominator;
+        fraction |= 1;
+      }
+    }
+    rateLimitQ16 = (whole > 0xFFFF) ? SRL_Q16_MAX_DISTANCE : (whole << 16) + fraction;
+}
+
+void FractionalSlewRateLimiter::setRateLimitQ16(long limit) 
+{
+    rateLimitQ16 = (limit <= 0) ? 0 : ((unsigned long)limit > SRL_Q16_MAX_DISTANCE) ? SRL_Q16_MAX_DISTANCE : (uint32_t)limit;
+}
+
+long FractionalSlewRateLimiter::getRateLimitQ16() const
+{
+    return (long)rateLimitQ16;
+}
+
+long FractionalSlewRateLimiter::getValueQ16() const
+{
+    return lastValueQ16;
+}
+
+void FractionalSlewRateLimiter::setHysteresisBand(int band) 
+{
+    // A negative band never snaps, like a band of zero: the output only lands on a target it reaches
+    hysteresisBandQ16 = (band <= 0) ? 0 : ((unsigned long)band > 0xFFFFUL) ? 0xFFFFFFFFUL : (uint32_t)band << 16;
+}
+
+void FractionalSlewRateLimiter::setSmoothingExponent(SlewRateLimiter::SRL_SmoothingExponent exponent) 
+{
+    currentExponent = exponent;
+}
+
+void FractionalSlewRateLimiter::setAdaptiveSlope(int slope) 
+{
+    // Same percentage to scale-of-128 conversion as SlewRateLimiter::setAdaptiveSlope, clamped to 0 .. 32767
+    int32_t internal = ((int32_t)slope * 128 + 50) / 100;
+    adaptiveSlopeInternal = (internal < 0) ? 0 : (internal > 32767) ? 32767 : internal;
+}
+
+void FractionalSlewRateLimiter::setEMAMode(SlewRateLimiter::SRL_EMAMode mode) 
+{
+    emaMode = mode;
+}
+
+int FractionalSlewRateLimiter::getEMA() const
+{
+    return (int)emaValue;
+}
+
+void FractionalSlewRateLimiter::reset() 
+{
+    isFirstCall = true;
+    lastValueQ16 = 0;
+    emaValue = 0;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file FractionalSlewRateLimiter.h
+ * @brief A slew rate limiter with a fractional (sub-LSB per sample) rate limit.
+ *
+ * SlewRateLimiter takes the rate limit in whole units per sample, so at a 10 kHz loop rate the slowest ramp
+ * it can express is 10,000 units per second. FractionalSlewRateLimiter keeps the last output value in Q16.16
+ * fixed point (a long with 16 fractional bits), and the rate limit in the same format, so it can ramp by
+ * fractions of a unit per sample at the full loop rate, e.g. 1/40 of a unit per sample for 250 units per
+ * second at 10 kHz. The output is the Q16.16 value rounded to the nearest integer.
+ *
+ * The EMA modes, the smoothing exponent, the adaptive slope and the hysteresis band work as in
+ * SlewRateLimiter. The adaptive slope is applied to the whole-unit part of the distance to the target, and
+ * the hysteresis band is compared with the exact Q16.16 distance.
+ *
+ * Inputs must be in the int16_t range (-32768 .. 32767, e.g. ADC values), which is what Q16.16 holds. Rate
+ * limits are clamped to 0 .. 65535 units per sample and the internal adaptive slope to 0 .. 32767. With a
+ * whole-unit rate limit and inputs in that range, the outputs are bit-exact with SlewRateLimiter.
+ *
+ * The update has no data-dependent branches: the step towards the target is a min() of the distance and
+ * the allowed change, and the hysteresis snap is a select.
+ *
+ * Major methods:
+ * - processValue: Applies rate limiting to an input value and returns the rounded output.
+ * - setRateLimit: Whole units per sample, as SlewRateLimiter::setRateLimit.
+ * - setRateLimitFraction: numerator / denominator units per sample, e.g. (units per second, loop rate in Hz).
+ * - setRateLimitQ16, getRateLimitQ16: The rate limit as a raw Q16.16 value.
+ * - getValueQ16: The last output value with its fractional bits.
+ * - setHysteresisBand, setSmoothingExponent, setAdaptiveSlope, setEMAMode, getEMA, reset: As SlewRateLimiter.
+ *
+ * Major variables:
+ * - lastValueQ16: The last output value, Q16.16.
+ * - rateLimitQ16: The allowed change per sample, Q16.16.
+ */
+
+#ifndef FractionalSlewRateLimiter_h
+#define FractionalSlewRateLimiter_h
+
+#include "SlewRateLimiter.h"
+
+class FractionalSlewRateLimiter 
+{
+public:
+    FractionalSlewRateLimiter(
+        SlewRateLimiter::SRL_SmoothingExponent exponent = SlewRateLimiter::SRL_SMOOTHING_4, 
+        int rate = 5, 
+        int hystBand = 2,
+        int slope = 0,
+        SlewRateLimiter::SRL_EMAMode mode = SlewRateLimiter::SRL_EMA_TRACK
+    );
+
+    int processValue(int currentValue);
+    void setRateLimit(int limit);
+    void setRateLimitFraction(long numerator, long denominator);
+    void setRateLimitQ16(long limit);
+    long getRateLimitQ16() const;
+    long getValueQ16() const;
+    void setHysteresisBand(int band);
+    void setSmoothingExponent(SlewRateLimiter::SRL_SmoothingExponent exponent);
+    void setAdaptiveSlope(int slope);
+    void setEMAMode(SlewRateLimiter::SRL_EMAMode mode);
+    int getEMA() const;
+    void reset();
+
+private:
+    int32_t lastValueQ16;
+    int32_t emaValue;
+    bool isFirstCall;
+    SlewRateLimiter::SRL_EMAMode emaMode;
+    SlewRateLimiter::SRL_SmoothingExponent currentExponent;
+    uint32_t rateLimitQ16;
+    uint32_t hysteresisBandQ16;
+    int32_t adaptiveSlopeInternal;
+};
+
+#endif /* FractionalSlewRateLimiter_h */
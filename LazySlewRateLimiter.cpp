@@ -0,0 +1,106 @@
+/**
+ * @file LazySlewRateLimiter.cpp
+ * @brief Implements the LazySlewRateLimiter class, a slew rate limiter evaluated on read.
+ *
+ * Between two evaluations the target is constant, so the ticks in between are exactly one advance call:
+ * evaluate counts the ticks whose timestamps have passed and hands them to SlewRateLimiter::advance.
+ *
+ * Methods:
+ * - setTarget: Evaluates the ticks before the write with the old target, then records the new one.
+ * - getValue, getEMA: Evaluate the ticks up to the timestamp and return the output or the EMA.
+ * - setRateLimit, setHysteresisBand, setSmoothingExponent, setAdaptiveSlope, setEMAMode: Forward to the limiter.
+ * - reset: Resets the limiter and stops the tick clock.
+ */
+
+
+#include "LazySlewRateLimiter.h"
+
+LazySlewRateLimiter::LazySlewRateLimiter(
+    unsigned long tickPeriodMicros,
+    SlewRateLimiter::SRL_SmoothingExponent exponent, 
+    int rate, 
+    int hystBand, 
+    int slope,
+    SlewRateLimiter::SRL_EMAMode mode
+)
+  : limiter(exponent, rate, hystBand, slope, mode),
+    target(0),
+    tickPeriod(tickPeriodMicros > 0 ? (uint32_t)tickPeriodMicros : 1),
+    lastTick(0),
+    started(false)
+{
+}
+
+void LazySlewRateLimiter::setTarget(int value, unsigned long timestampMicros)
+{
+  if (!started)
+  {
+    // The first write starts the tick clock: its first tick is one period later
+    started = true;
+    lastTick = (uint32_t)timestampMicros;
+  }
+  else
+  {
+    evaluate(timestampMicros);
+  }
+  target = value;
+}
+
+int LazySlewRateLimiter::getValue(unsigned long timestampMicros)
+{
+  evaluate(timestampMicros);
+  return limiter.getValue();
+}
+
+int LazySlewRateLimiter::getEMA(unsigned long timestampMicros)
+{
+  evaluate(timestampMicros);
+  return limiter.getEMA();
+}
+
+void LazySlewRateLimiter::setRateLimit(int limit)
+{
+    limiter.setRateLimit(limit);
+}
+
+void LazySlewRateLimiter::setHysteresisBand(int band)
+{
+    limiter.setHysteresisBand(band);
+}
+
+void LazySlewRateLimiter::setSmoothingExponent(SlewRateLimiter::SRL_SmoothingExponent exponent)
+{
+    limiter.setSmoothingExponent(exponent);
+}
+
+void LazySlewRateLimiter::setAdaptiveSlope(int slope)
+{
+    limiter.setAdaptiveSlope(slope);
+}
+
+void LazySlewRateLimiter::setEMAMode(SlewRateLimiter::SRL_EMAMode mode)
+{
+    limiter.setEMAMode(mode);
+}
+
+void LazySlewRateLimiter::reset()
+{
+  limiter.reset();
+  target = 0;
+  lastTick = 0;
+  started = false;
+}
+
+void LazySlewRateLimiter::evaluate(unsigned long timestampMicros)
+{
+  // Only the 32-bit difference is used, as in processValueAt, so the wrap-around of micros() is harmless.
+  // Most writes land within the current tick and stop at the comparison, without a division.
+  uint32_t elapsed = (uint32_t)timestampMicros - lastTick;
+  if (!started || elapsed < tickPeriod)
+  {
+    return;
+  }
+  uint32_t ticks = elapsed / tickPeriod;
+  lastTick += ticks * tickPeriod;
+  limiter.advance(target, ticks);
+}
@@ -0,0 +1,74 @@
+/**
+ * @file LazySlewRateLimiter.h
+ * @brief A slew rate limiter that is evaluated when it is read instead of on every tick.
+ *
+ * LazySlewRateLimiter has the semantics of a SlewRateLimiter whose processValue is called at a fixed tick
+ * period with the latest target, but it does no work per tick. A write records the new target at its
+ * timestamp, and a read computes the output from the ticks that have elapsed since the last evaluation
+ * with SlewRateLimiter::advance, which is closed-form for a fixed rate limit. This suits targets that are
+ * written often (several writes within one tick only cost one evaluation) and read rarely.
+ *
+ * Timing: the first setTarget starts the tick clock. Ticks fall every tickPeriodMicros after it, and each
+ * tick processes the target written most recently before it; a target written at the timestamp of a tick
+ * takes effect on the next tick. A read at a timestamp returns the output after every tick up to and
+ * including that timestamp, i.e. what processValue would have returned on the last of them. As with
+ * SlewRateLimiter::processValueAt, only 32-bit differences are used, so micros() wrapping around is harmless,
+ * but timestamps must not go backwards and the limiter must be read or written at least once every 2^32 us
+ * (about 71 minutes).
+ *
+ * Major methods:
+ * - setTarget: Records a new target at a timestamp in microseconds.
+ * - getValue, getEMA: Evaluate the limiter up to a timestamp and return its output or EMA.
+ * - setRateLimit, setHysteresisBand, setSmoothingExponent, setAdaptiveSlope, setEMAMode: As SlewRateLimiter,
+ *   applied from the last evaluated tick on.
+ * - reset: Forgets the target and stops the tick clock until the next setTarget.
+ *
+ * Major variables:
+ * - limiter: The limiter, as of the last evaluated tick.
+ * - target: The latest target.
+ * - tickPeriod: The declared tick period in microseconds.
+ * - lastTick: The timestamp of the last evaluated tick.
+ * - started: Whether setTarget has started the tick clock.
+ *
+ * @note With the adaptive slope or the EMA, advance steps the limiter until the output and EMA stop changing,
+ *       so a read after a long idle stretch costs a bounded number of steps (see SlewRateLimiter::advance).
+ */
+
+#ifndef LazySlewRateLimiter_h
+#define LazySlewRateLimiter_h
+
+#include "SlewRateLimiter.h"
+
+class LazySlewRateLimiter 
+{
+public:
+    LazySlewRateLimiter(
+        unsigned long tickPeriodMicros,
+        SlewRateLimiter::SRL_SmoothingExponent exponent = SlewRateLimiter::SRL_SMOOTHING_4, 
+        int rate = 5, 
+        int hystBand = 2,
+        int slope = 0,
+        SlewRateLimiter::SRL_EMAMode mode = SlewRateLimiter::SRL_EMA_TRACK
+    );
+
+    void setTarget(int value, unsigned long timestampMicros);
+    int getValue(unsigned long timestampMicros);
+    int getEMA(unsigned long timestampMicros);
+    void setRateLimit(int limit);
+    void setHysteresisBand(int band);
+    void setSmoothingExponent(SlewRateLimiter::SRL_SmoothingExponent exponent);
+    void setAdaptiveSlope(int slope);
+    void setEMAMode(SlewRateLimiter::SRL_EMAMode mode);
+    void reset();
+
+private:
+    void evaluate(unsigned long timestampMicros);
+
+    SlewRateLimiter limiter;
+    int target;
+    uint32_t tickPeriod;
+    uint32_t lastTick;
+    bool started;
+};
+
+#endif /* LazySlewRateLimiter_h */
@@ -13,26 +13,65 @@
  * - Fixed slew rate limiting: A constant maximum change is allowed between successive output values.
  * - Adaptive slew rate limiting: The rate of change is allowed to increase with larger input deviations.
  * - Hysteresis: Prevents changes to the output when the input changes are within a certain range, reducing noise.
- * - EMA Smoothing: Smooths out the input signal fluctuations using an Exponential Moving Average.
+ * - EMA Smoothing: Smooths out the input signal fluctuations using an Exponential Moving Average. The EMA can
+ *   be tracked alongside the output, drive the limiter (the smoothed signal is limited instead of the raw
+ *   input), or be switched off entirely to save its cost on the hot path.
  *
  * Major methods:
  * - processValue: Processes an input value and returns the limited output.
+ * - processBlock: Processes a buffer of input values, bit-exact with repeated processValue calls.
+ * - advance: Fast-forwards over n samples of the same input value, with the result of n processValue calls.
+ * - isSettled: Whether the output has reached the last input (in drive mode: the settled EMA), so further
+ *   calls with the same input are no-ops.
+ * - ticksToSettle: How many processValue calls with a given input it takes to settle (SRL_NEVER_SETTLES if
+ *   the output never reaches it, e.g. with a zero rate limit).
+ * - processValueAt: Processes an input value sampled at a timestamp in microseconds, with the rate limit
+ *   given in units per second and scaled by the time elapsed since the previous call.
  * - setRateLimit: Sets the fixed rate limit.
+ * - setRateLimitPerSecond: Sets the fixed rate limit used by processValueAt, in units per second.
  * - setHysteresisBand: Sets the width of the hysteresis band.
  * - setSmoothingExponent: Sets the exponent used for EMA calculation.
  * - setAdaptiveSlope: Sets the slope for adaptive rate limiting.
+ * - setEMAMode: Selects whether the EMA is tracked, drives the limiter, or is skipped.
+ * - getValue: Returns the last output, without processing anything.
+ * - getEMA: Returns the current value of the Exponential Moving Average.
+ * - getState, setState: Snapshot and restore the state (last output, EMA, first call) as an SRL_State, e.g. to
+ *   warm-restart a process without an actuator step.
  * - reset: Resets the EMA and last output value.
  *
  * Major variables:
  * - lastValue: The last output value after rate limiting and hysteresis.
+ * - lastInput: The last input value, for isSettled.
  * - emaValue: The current value of the Exponential Moving Average.
  * - currentExponent: The exponent used for the EMA calculation.
+ * - emaMode: How the EMA takes part in processing (see SRL_EMAMode).
  * - rateLimit: The maximum allowed change per output update in fixed mode.
  * - hysteresisBand: The range within which output changes are suppressed to reduce noise.
  * - adaptiveSlopeInternal: The factor by which the rate limit increases with larger input deviations.
+ * - ratePerMicroWhole, ratePerMicroFraction: The processValueAt rate limit per microsecond, in 32.32 fixed point.
+ * - rateCarry: The fraction of a unit allowed by processValueAt but not used yet, carried to the next call.
+ * - lastTimestamp: The timestamp of the previous processValueAt call.
+ * - clockStarted: Whether lastTimestamp is valid: false until the first processValueAt call after construction,
+ *   reset or setState.
  *
  * @note This library is designed to be efficient enough for use in real-time systems, such as those based on Arduino.
  *
+ * @note Define SRL_HEADER_ONLY (for the whole build, e.g. with -DSRL_HEADER_ONLY) to get inline definitions of
+ *       every method from this header, so the compiler can fuse processValue into the caller's control loop
+ *       without link-time optimization. Otherwise the methods are compiled once in SlewRateLimiter.cpp.
+ *
+ * @note Define SRL_WIDE_EMA (for the whole build) to keep the EMA in a fixed-point accumulator twice as wide as
+ *       int (see SlewRateLimiterEMA.h). This handles full-range 16-bit ADC values on AVR and has no
+ *       truncation bias, at the cost of wide arithmetic for the EMA update only. SlewRateLimiterBank and its
+ *       kernels always use the classic EMA.
+ *
+ * @note Define SRL_BRANCHLESS (for the whole build) to compile the rate limiting, the adaptive slope and the
+ *       hysteresis of processValue without data-dependent branches: the step is clamped with min/max, the
+ *       adaptive term is always added (it is zero without a slope) and the hysteresis snap is a mask. The
+ *       clamps compile to conditional moves on x86 and to IT blocks on Cortex-M. This avoids mispredictions
+ *       on noisy input, at the cost of always doing the work of every stage. The results are identical for
+ *       non-negative rate limits and slopes.
+ *
  * @author  Andrew McKinnon
  * @date    2023-11-3
  */
@@ -40,7 +79,13 @@
 #ifndef SlewRateLimiter_h
 #define SlewRateLimiter_h
 
-#include "Arduino.h"
+#include "SlewRateLimiterPlatform.h"
+#include "SlewRateLimiterEMA.h"
+#include "SlewRateLimiterState.h"
+#include "SlewRateLimiterStep.h"
+
+// Returned by SlewRateLimiter::ticksToSettle when the output never reaches the target
+#define SRL_NEVER_SETTLES ((unsigned long)-1)
 
 class SlewRateLimiter 
 {
@@ -58,29 +103,71 @@ public:
         SRL_SMOOTHING_512 = 9
     };
 
+    enum SRL_EMAMode {
+        SRL_EMA_TRACK = 0,  // EMA is updated every sample but does not affect the output (default)
+        SRL_EMA_OFF = 1,    // EMA is not computed; getEMA returns the first input after a reset
+        SRL_EMA_DRIVE = 2   // The EMA is rate limited instead of the raw input
+    };
+
     SlewRateLimiter(
         SRL_SmoothingExponent exponent = SRL_SMOOTHING_4, 
         int rate = 5, 
         int hystBand = 2,
-        int slope = 0
+        int slope = 0,
+        SRL_EMAMode mode = SRL_EMA_TRACK
     );
 
     int processValue(int currentValue);
+    int processValueAt(int currentValue, unsigned long timestampMicros);
+    int advance(int currentValue, unsigned long n);
+    bool isSettled() const;
+    unsigned long ticksToSettle(int target) const;
+    void processBlock(const int* in, int* out, size_t n);
     void setRateLimit(int limit);
+    void setRateLimitPerSecond(unsigned long unitsPerSecond);
     void setHysteresisBand(int band);
     void setSmoothingExponent(SRL_SmoothingExponent exponent);
     void setAdaptiveSlope(int slope);
+    void setEMAMode(SRL_EMAMode mode);
+    int getValue() const;
+    int getEMA() const;
+    SRL_State getState() const;
+    void setState(const SRL_State& state);
     void reset();
 
 private:
-    int updateEMA(int newValue, int currentEMA, SRL_SmoothingExponent smoothingExponent);
+#ifdef SRL_WIDE_EMA
+    typedef SRL_WideEMA<int>::Accumulator EMAStorage;
+#else
+    typedef int EMAStorage;
+#endif
+    static inline EMAStorage initEMA(int value);
+    static inline EMAStorage updateEMA(int newValue, EMAStorage currentEMA, SRL_SmoothingExponent smoothingExponent);
+    static inline int emaOutput(EMAStorage ema);
+    inline int limitValue(int currentValue, int rate);
+    inline void advanceOutput(int target, unsigned long n);
+    inline bool settledOn(int input) const;
+    template <bool Adaptive, SRL_EMAMode Mode>
+    void processBlockLoop(const int* in, int* out, size_t begin, size_t n);
     int lastValue;
-    int emaValue;
+    int lastInput;
+    EMAStorage emaValue;
     bool isFirstCall;
+    bool clockStarted;
+    SRL_EMAMode emaMode;
     SRL_SmoothingExponent currentExponent;
     int rateLimit;
     int hysteresisBand;
     int adaptiveSlopeInternal;
+    uint32_t ratePerMicroWhole;
+    uint32_t ratePerMicroFraction;
+    uint32_t rateCarry;
+    unsigned long lastTimestamp;
 };
 
+#ifdef SRL_HEADER_ONLY
+#define SRL_INLINE inline
+#include "SlewRateLimiterImpl.h"
+#endif
+
 #endif /* SlewRateLimiter_h */
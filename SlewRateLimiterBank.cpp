@@ -0,0 +1,280 @@
+/**
+ * @file SlewRateLimiterBank.cpp
+ * @brief Implements the SlewRateLimiterBank class, a structure-of-arrays bank of slew rate limiters.
+ *
+ * Each channel behaves exactly like its own SlewRateLimiter instance: the EMA update, the fixed and
+ * adaptive rate limiting and the hysteresis are the same integer operations as in processValue. The
+ * per-channel update is done by the kernels in SlewRateLimiterKernels.h, which select the first-call
+ * handling and the adaptive slope per channel rather than branching on them, so they can be vectorized.
+ *
+ * Methods:
+ * - processAll: Updates every channel with its new input value.
+ * - setInput, tick: Store a channel's input (waking it if it changed) and update the active channels.
+ * - activate, activateAll: Add channels to the active set after a change that can move them.
+ * - configure: Sets the initial configuration of every channel, for both constructors.
+ * - activeCount, isActive: Report the active set.
+ * - getValue: Returns the last output value of a channel.
+ * - setRateLimit, setHysteresisBand, setSmoothingExponent, setAdaptiveSlope: Per-channel configuration.
+ * - setEMAMode: Selects the EMA mode of the whole bank.
+ * - getEMA: Returns the EMA of a channel.
+ * - getStates, setStates: Copy the state arrays to and from an array of SRL_State.
+ * - reset: Reinitializes the state of one channel or of the whole bank.
+ */
+
+
+#include "SlewRateLimiterBank.h"
+#include "SlewRateLimiterKernels.h"
+
+// activeSlot value of a channel that is not in the active set
+static const size_t SRL_INACTIVE_SLOT = (size_t)-1;
+
+SlewRateLimiterBank::SlewRateLimiterBank(
+    size_t channels,
+    SlewRateLimiter::SRL_SmoothingExponent exponent, 
+    int rate, 
+    int hystBand, 
+    int slope,
+    SlewRateLimiter::SRL_EMAMode mode
+)
+  : channelCount(channels),
+    emaMode(mode),
+    lastValue(new int[channels]),
+    emaValue(new int[channels]),
+    rateLimit(new int[channels]),
+    hysteresisBand(new int[channels]),
+    adaptiveSlopeInternal(new int[channels]),
+    smoothingExponent(new unsigned char[channels]),
+    firstCall(new unsigned char[channels]),
+    inputValue(new int[channels]),
+    activeChannels(new size_t[channels]),
+    activeChannelCount(0),
+    activeSlot(new size_t[channels]),
+    ownsState(true)
+{
+  configure(exponent, rate, hystBand, slope);
+  reset();
+}
+
+SlewRateLimiterBank::SlewRateLimiterBank(
+    size_t channels,
+    int* lastValues,
+    int* emaValues,
+    unsigned char* firstCalls,
+    SlewRateLimiter::SRL_SmoothingExponent exponent, 
+    int rate, 
+    int hystBand, 
+    int slope,
+    SlewRateLimiter::SRL_EMAMode mode
+)
+  : channelCount(channels),
+    emaMode(mode),
+    lastValue(lastValues),
+    emaValue(emaValues),
+    rateLimit(new int[channels]),
+    hysteresisBand(new int[channels]),
+    adaptiveSlopeInternal(new int[channels]),
+    smoothingExponent(new unsigned char[channels]),
+    firstCall(firstCalls),
+    inputValue(new int[channels]),
+    activeChannels(new size_t[channels]),
+    activeChannelCount(0),
+    activeSlot(new size_t[channels]),
+    ownsState(false)
+{
+  configure(exponent, rate, hystBand, slope);
+
+  // Resume from the given state: as after setStates, every channel holds its output until its input is set
+  for (size_t c = 0; c < channelCount; c++)
+  {
+    inputValue[c] = lastValue[c];
+  }
+  activateAll();
+}
+
+SlewRateLimiterBank::~SlewRateLimiterBank()
+{
+  if (ownsState)
+  {
+    delete[] lastValue;
+    delete[] emaValue;
+    delete[] firstCall;
+  }
+  delete[] rateLimit;
+  delete[] hysteresisBand;
+  delete[] adaptiveSlopeInternal;
+  delete[] smoothingExponent;
+  delete[] inputValue;
+  delete[] activeChannels;
+  delete[] activeSlot;
+}
+
+size_t SlewRateLimiterBank::size() const
+{
+  return channelCount;
+}
+
+void SlewRateLimiterBank::processAll(const int* inputs, int* outputs)
+{
+  SRL_BankArrays arrays = {
+    emaMode, lastValue, emaValue, rateLimit, hysteresisBand, adaptiveSlopeInternal, smoothingExponent, firstCall
+  };
+  SRL_bankKernelDispatch(arrays, inputs, outputs, channelCount);
+}
+
+void SlewRateLimiterBank::setInput(size_t channel, int value)
+{
+  if (inputValue[channel] != value)
+  {
+    inputValue[channel] = value;
+    activate(channel);
+  }
+}
+
+void SlewRateLimiterBank::tick()
+{
+  SRL_BankArrays arrays = {
+    emaMode, lastValue, emaValue, rateLimit, hysteresisBand, adaptiveSlopeInternal, smoothingExponent, firstCall
+  };
+  const bool emaOn = emaMode != SlewRateLimiter::SRL_EMA_OFF;
+  const bool drive = emaMode == SlewRateLimiter::SRL_EMA_DRIVE;
+
+  size_t i = 0;
+  while (i < activeChannelCount)
+  {
+    size_t channel = activeChannels[i];
+    if (SRL_bankUpdateChannel(arrays, inputValue, lastValue, channel, emaOn, drive))
+    {
+      i++;
+      continue;
+    }
+
+    // Unchanged, so every further tick with this input is a no-op: swap-remove it from the active set.
+    // The channel moved into slot i has not been processed yet this tick, so i stays.
+    size_t moved = activeChannels[--activeChannelCount];
+    activeChannels[i] = moved;
+    activeSlot[moved] = i;
+    activeSlot[channel] = SRL_INACTIVE_SLOT;
+  }
+}
+
+size_t SlewRateLimiterBank::activeCount() const
+{
+  return activeChannelCount;
+}
+
+bool SlewRateLimiterBank::isActive(size_t channel) const
+{
+  return activeSlot[channel] != SRL_INACTIVE_SLOT;
+}
+
+void SlewRateLimiterBank::configure(SlewRateLimiter::SRL_SmoothingExponent exponent, int rate, int hystBand,
+                                    int slope)
+{
+  for (size_t c = 0; c < channelCount; c++)
+  {
+    inputValue[c] = 0;
+    activeSlot[c] = SRL_INACTIVE_SLOT;
+    rateLimit[c] = rate;
+    hysteresisBand[c] = hystBand;
+    smoothingExponent[c] = (unsigned char)exponent;
+    setAdaptiveSlope(c, slope);
+  }
+}
+
+void SlewRateLimiterBank::activate(size_t channel)
+{
+  if (activeSlot[channel] == SRL_INACTIVE_SLOT)
+  {
+    activeSlot[channel] = activeChannelCount;
+    activeChannels[activeChannelCount++] = channel;
+  }
+}
+
+void SlewRateLimiterBank::activateAll()
+{
+  for (size_t c = 0; c < channelCount; c++)
+  {
+    activate(c);
+  }
+}
+
+int SlewRateLimiterBank::getValue(size_t channel) const
+{
+  return lastValue[channel];
+}
+
+int SlewRateLimiterBank::getEMA(size_t channel) const
+{
+  return emaValue[channel];
+}
+
+void SlewRateLimiterBank::setRateLimit(size_t channel, int limit) 
+{
+    rateLimit[channel] = limit;
+    activate(channel);
+}
+
+void SlewRateLimiterBank::setHysteresisBand(size_t channel, int band) 
+{
+    hysteresisBand[channel] = band;
+    activate(channel);
+}
+
+void SlewRateLimiterBank::setSmoothingExponent(size_t channel, SlewRateLimiter::SRL_SmoothingExponent exponent) 
+{
+    smoothingExponent[channel] = (unsigned char)exponent;
+    activate(channel);
+}
+
+void SlewRateLimiterBank::setAdaptiveSlope(size_t channel, int slope) 
+{
+    // Same percentage to scale-of-128 conversion as SlewRateLimiter::setAdaptiveSlope
+    adaptiveSlopeInternal[channel] = (slope * 128 + 50) / 100;
+    activate(channel);
+}
+
+void SlewRateLimiterBank::setEMAMode(SlewRateLimiter::SRL_EMAMode mode) 
+{
+    emaMode = mode;
+    activateAll();
+}
+
+void SlewRateLimiterBank::getStates(SRL_State* states) const
+{
+  for (size_t c = 0; c < channelCount; c++)
+  {
+    SRL_State state = { (int32_t)lastValue[c], (int32_t)emaValue[c] };
+    states[c] = firstCall[c] ? SRL_initialState() : state;
+  }
+}
+
+void SlewRateLimiterBank::setStates(const SRL_State* states)
+{
+  for (size_t c = 0; c < channelCount; c++)
+  {
+    bool first = SRL_isFirstCall(states[c]);
+    firstCall[c] = first ? 1 : 0;
+    lastValue[c] = first ? 0 : (int)states[c].lastValue;
+    emaValue[c] = first ? 0 : (int)states[c].emaValue;
+
+    // The inputs are not part of the snapshot: until setInput says otherwise, a channel holds its output
+    inputValue[c] = lastValue[c];
+  }
+  activateAll();
+}
+
+void SlewRateLimiterBank::reset(size_t channel) 
+{
+    firstCall[channel] = 1;
+    lastValue[channel] = 0;
+    emaValue[channel] = 0;
+    activate(channel);
+}
+
+void SlewRateLimiterBank::reset() 
+{
+    for (size_t c = 0; c < channelCount; c++)
+    {
+        reset(c);
+    }
+}
@@ -0,0 +1,115 @@
+/**
+ * @file SlewRateLimiterBank.h
+ * @brief A bank of independent slew rate limiters stored as a structure of arrays.
+ *
+ * The SlewRateLimiterBank class runs many independent limiters, one per channel, with the same semantics
+ * as calling SlewRateLimiter::processValue on each channel. Instead of one object per channel, every
+ * field of the limiter state and configuration is stored in its own contiguous array, so a tick over
+ * all channels walks memory linearly and the per-channel update can be vectorized by the compiler.
+ *
+ * Active-set processing: setInput stores a channel's input and tick updates the channels with their stored
+ * inputs. A channel whose update leaves its output and EMA unchanged is at a fixed point, so tick drops it
+ * from a compact list of active channels (swap-remove, O(1)) and skips it until its input or configuration
+ * changes. The result is the same as processing every channel on every tick, at a cost proportional to the
+ * number of channels still ramping or smoothing.
+ *
+ * Major methods:
+ * - processAll: Processes one input value per channel and writes one output value per channel.
+ * - setInput, tick: Active-set processing; getValue returns the outputs.
+ * - activeCount, isActive: Report the size of the active set and whether a channel is in it.
+ * - setRateLimit, setHysteresisBand, setSmoothingExponent, setAdaptiveSlope: Per-channel configuration.
+ * - setEMAMode: Bank-wide EMA mode, as SlewRateLimiter::setEMAMode.
+ * - getValue, getEMA: Return the last output value or the EMA of a channel.
+ * - getStates, setStates: Bulk snapshot and restore of every channel's state as an array of SRL_State.
+ * - reset: Resets one channel, or every channel.
+ *
+ * Major variables:
+ * - lastValue, emaValue: Per-channel limiter state.
+ * - rateLimit, hysteresisBand, adaptiveSlopeInternal, smoothingExponent: Per-channel configuration.
+ * - firstCall: Per-channel flag, non-zero until the channel has processed its first value.
+ * - inputValue: Per-channel input stored by setInput, for tick.
+ * - activeChannels, activeChannelCount: The active set, as a compact list of channel indices.
+ * - activeSlot: Per-channel position in activeChannels, or SRL_INACTIVE_SLOT.
+ * - ownsState: Whether lastValue, emaValue and firstCall were allocated by the bank.
+ *
+ * @note The arrays are allocated once in the constructor; processAll and tick never allocate. The second
+ *       constructor takes the state arrays (lastValue, emaValue, firstCall) from the caller instead, e.g. from
+ *       a memory-mapped file (SlewRateLimiterMappedBank.h): it resumes from their contents rather than
+ *       resetting them, and does not free them.
+ * @note processAll and tick are alternatives: processAll does not read the stored inputs, and tick only
+ *       tracks changes made through setInput and the setters.
+ */
+
+#ifndef SlewRateLimiterBank_h
+#define SlewRateLimiterBank_h
+
+#include "SlewRateLimiter.h"
+
+class SlewRateLimiterBank 
+{
+public:
+    SlewRateLimiterBank(
+        size_t channels,
+        SlewRateLimiter::SRL_SmoothingExponent exponent = SlewRateLimiter::SRL_SMOOTHING_4, 
+        int rate = 5, 
+        int hystBand = 2,
+        int slope = 0,
+        SlewRateLimiter::SRL_EMAMode mode = SlewRateLimiter::SRL_EMA_TRACK
+    );
+    SlewRateLimiterBank(
+        size_t channels,
+        int* lastValues,
+        int* emaValues,
+        unsigned char* firstCalls,
+        SlewRateLimiter::SRL_SmoothingExponent exponent = SlewRateLimiter::SRL_SMOOTHING_4, 
+        int rate = 5, 
+        int hystBand = 2,
+        int slope = 0,
+        SlewRateLimiter::SRL_EMAMode mode = SlewRateLimiter::SRL_EMA_TRACK
+    );
+    ~SlewRateLimiterBank();
+
+    size_t size() const;
+    void processAll(const int* inputs, int* outputs);
+    void setInput(size_t channel, int value);
+    void tick();
+    size_t activeCount() const;
+    bool isActive(size_t channel) const;
+    int getValue(size_t channel) const;
+    int getEMA(size_t channel) const;
+    void getStates(SRL_State* states) const;
+    void setStates(const SRL_State* states);
+    void setRateLimit(size_t channel, int limit);
+    void setHysteresisBand(size_t channel, int band);
+    void setSmoothingExponent(size_t channel, SlewRateLimiter::SRL_SmoothingExponent exponent);
+    void setAdaptiveSlope(size_t channel, int slope);
+    void setEMAMode(SlewRateLimiter::SRL_EMAMode mode);
+    void reset(size_t channel);
+    void reset();
+
+private:
+    // Not copyable: the bank owns its arrays
+    SlewRateLimiterBank(const SlewRateLimiterBank&);
+    SlewRateLimiterBank& operator=(const SlewRateLimiterBank&);
+
+    void activate(size_t channel);
+    void activateAll();
+    void configure(SlewRateLimiter::SRL_SmoothingExponent exponent, int rate, int hystBand, int slope);
+
+    size_t channelCount;
+    SlewRateLimiter::SRL_EMAMode emaMode;
+    int* lastValue;
+    int* emaValue;
+    int* rateLimit;
+    int* hysteresisBand;
+    int* adaptiveSlopeInternal;
+    unsigned char* smoothingExponent;
+    unsigned char* firstCall;
+    int* inputValue;
+    size_t* activeChannels;
+    size_t activeChannelCount;
+    size_t* activeSlot;
+    bool ownsState;
+};
+
+#endif /* SlewRateLimiterBank_h */
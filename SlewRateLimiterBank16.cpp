@@ -0,0 +1,124 @@
+/**
+ * @file SlewRateLimiterBank16.cpp
+ * @brief Implements the SlewRateLimiterBank16 class, a structure-of-arrays bank of 16-bit slew rate limiters.
+ *
+ * The per-channel update is done by the 16-bit kernels in SlewRateLimiterKernels.h. The setters clamp the
+ * rate limit and the adaptive slope to the range the kernels support (see SlewRateLimiterBank16.h).
+ *
+ * Methods:
+ * - processAll: Updates every channel with its new input value.
+ * - getValue: Returns the last output value of a channel.
+ * - setRateLimit, setHysteresisBand, setSmoothingExponent, setAdaptiveSlope: Per-channel configuration.
+ * - setEMAMode: Selects the EMA mode of the whole bank.
+ * - getEMA: Returns the EMA of a channel.
+ * - reset: Reinitializes the state of one channel or of the whole bank.
+ */
+
+
+#include "SlewRateLimiterBank16.h"
+#include "SlewRateLimiterKernels.h"
+
+SlewRateLimiterBank16::SlewRateLimiterBank16(
+    size_t channels,
+    SlewRateLimiter::SRL_SmoothingExponent exponent, 
+    int16_t rate, 
+    int16_t hystBand, 
+    int slope,
+    SlewRateLimiter::SRL_EMAMode mode
+)
+  : channelCount(channels),
+    emaMode(mode),
+    lastValue(new int16_t[channels]),
+    emaValue(new int16_t[channels]),
+    rateLimit(new int16_t[channels]),
+    hysteresisBand(new int16_t[channels]),
+    adaptiveSlopeInternal(new int16_t[channels]),
+    smoothingExponent(new unsigned char[channels]),
+    firstCall(new unsigned char[channels])
+{
+  for (size_t c = 0; c < channelCount; c++)
+  {
+    setRateLimit(c, rate);
+    hysteresisBand[c] = hystBand;
+    smoothingExponent[c] = (unsigned char)exponent;
+    setAdaptiveSlope(c, slope);
+  }
+  reset();
+}
+
+SlewRateLimiterBank16::~SlewRateLimiterBank16()
+{
+  delete[] lastValue;
+  delete[] emaValue;
+  delete[] rateLimit;
+  delete[] hysteresisBand;
+  delete[] adaptiveSlopeInternal;
+  delete[] smoothingExponent;
+  delete[] firstCall;
+}
+
+size_t SlewRateLimiterBank16::size() const
+{
+  return channelCount;
+}
+
+void SlewRateLimiterBank16::processAll(const int16_t* inputs, int16_t* outputs)
+{
+  SRL_Bank16Arrays arrays = {
+    emaMode, lastValue, emaValue, rateLimit, hysteresisBand, adaptiveSlopeInternal, smoothingExponent, firstCall
+  };
+  SRL_bank16KernelDispatch(arrays, inputs, outputs, channelCount);
+}
+
+int16_t SlewRateLimiterBank16::getValue(size_t channel) const
+{
+  return lastValue[channel];
+}
+
+int16_t SlewRateLimiterBank16::getEMA(size_t channel) const
+{
+  return emaValue[channel];
+}
+
+void SlewRateLimiterBank16::setRateLimit(size_t channel, int16_t limit) 
+{
+    rateLimit[channel] = limit < 0 ? 0 : limit;
+}
+
+void SlewRateLimiterBank16::setHysteresisBand(size_t channel, int16_t band) 
+{
+    hysteresisBand[channel] = band;
+}
+
+void SlewRateLimiterBank16::setSmoothingExponent(size_t channel, SlewRateLimiter::SRL_SmoothingExponent exponent) 
+{
+    smoothingExponent[channel] = (unsigned char)exponent;
+}
+
+void SlewRateLimiterBank16::setAdaptiveSlope(size_t channel, int slope) 
+{
+    // Same percentage to scale-of-128 conversion as SlewRateLimiter::setAdaptiveSlope, done in 32 bits
+    // (int is 16 bits on AVR) and clamped to the 16-bit kernel range
+    int32_t internal = ((int32_t)slope * 128 + 50) / 100;
+    adaptiveSlopeInternal[channel] = internal < 0 ? 0 : internal > 32767 ? 32767 : (int16_t)internal;
+}
+
+void SlewRateLimiterBank16::setEMAMode(SlewRateLimiter::SRL_EMAMode mode) 
+{
+    emaMode = mode;
+}
+
+void SlewRateLimiterBank16::reset(size_t channel) 
+{
+    firstCall[channel] = 1;
+    lastValue[channel] = 0;
+    emaValue[channel] = 0;
+}
+
+void SlewRateLimiterBank16::reset() 
+{
+    for (size_t c = 0; c < channelCount; c++)
+    {
+        reset(c);
+    }
+}
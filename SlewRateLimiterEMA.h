@@ -0,0 +1,57 @@
+/**
+ * @file SlewRateLimiterEMA.h
+ * @brief Wide-accumulator EMA: an explicit fixed-point accumulator with a narrow output.
+ *
+ * The classic SlewRateLimiter EMA computes ((x << e) + (ema << 10) - (ema << e)) >> 10 in the sample type.
+ * On AVR, where int is 16 bits, that overflows for inputs above ~31 at the largest exponents. It also
+ * truncates on every update, so the EMA settles below a rising input instead of reaching it.
+ *
+ * SRL_WideEMA keeps the EMA in an accumulator with FRACTION_BITS (10) fractional bits, at least 10 bits wider
+ * than the sample type. The accumulator type is chosen at compile time from the sample width (8 and 16 -> 32,
+ * 32 -> 64 bits; 64-bit samples also get 64 bits, so they must stay well inside +-2^52). Only the update is
+ * done in the wide type:
+ *
+ *     acc += (x << e) - (acc >> (10 - e))        output = acc >> 10
+ *
+ * The fractional bits are carried from one update to the next, so the EMA converges exactly to a constant
+ * input. There is no truncation bias. For 8-bit samples the accumulator never exceeds 2^18 in magnitude, and for
+ * 16-bit samples 2^26.
+ *
+ * SlewRateLimiter uses this EMA instead of the classic one when SRL_WIDE_EMA is defined for the whole build.
+ */
+
+#ifndef SlewRateLimiterEMA_h
+#define SlewRateLimiterEMA_h
+
+#include "SlewRateLimiterPlatform.h"
+
+template <int SampleBytes> struct SRL_WideAccumulator;
+template <> struct SRL_WideAccumulator<1> { typedef int32_t type; };   // x << 10 needs 18 bits
+template <> struct SRL_WideAccumulator<2> { typedef int32_t type; };
+template <> struct SRL_WideAccumulator<4> { typedef int64_t type; };
+template <> struct SRL_WideAccumulator<8> { typedef int64_t type; };   // no wider portable type
+
+template <typename Sample>
+struct SRL_WideEMA
+{
+    typedef typename SRL_WideAccumulator<sizeof(Sample)>::type Accumulator;
+
+    enum { FRACTION_BITS = 10 };
+
+    static inline Accumulator init(Sample value)
+    {
+      return (Accumulator)value * (1 << FRACTION_BITS);
+    }
+
+    static inline Accumulator update(Sample newValue, Accumulator accumulator, int exponent)
+    {
+      return accumulator + (Accumulator)newValue * (1 << exponent) - (accumulator >> (FRACTION_BITS - exponent));
+    }
+
+    static inline Sample output(Accumulator accumulator)
+    {
+      return (Sample)(accumulator >> FRACTION_BITS);
+    }
+};
+
+#endif /* SlewRateLimiterEMA_h */
@@ -0,0 +1,186 @@
+/**
+ * @file SlewRateLimiterGroup.cpp
+ * @brief Implements SRL_Config and the SlewRateLimiterGroup class, channels that share one configuration.
+ *
+ * The per-channel update is the same sequence of integer operations as SlewRateLimiter::processValue, on an
+ * SRL_State. Because the configuration is the same for every channel, processAll hoists the EMA mode and
+ * the adaptive slope out of the loop, as SlewRateLimiter::processBlock does, and reads the configuration
+ * into locals once.
+ *
+ * Methods:
+ * - SRL_Config: Converts the adaptive slope to its internal scale, as SlewRateLimiter::setAdaptiveSlope.
+ * - processAll, processLoop: Update every channel, with the loop specialized for the configuration.
+ * - processValue: Updates one channel.
+ * - getValue, getEMA, getConfig: Accessors.
+ * - getStates, setStates: Copy the states out and in; they are already in SRL_State form.
+ * - reset: Puts one channel, or every channel, back into the first-call state.
+ */
+
+
+#include "SlewRateLimiterGroup.h"
+
+#include <string.h>
+
+SRL_Config::SRL_Config(
+    SlewRateLimiter::SRL_SmoothingExponent smoothing, 
+    int rate, 
+    int hystBand, 
+    int slope,
+    SlewRateLimiter::SRL_EMAMode mode
+)
+  : rateLimit(rate),
+    hysteresisBand(hystBand),
+    // Same percentage to scale-of-128 conversion as SlewRateLimiter::setAdaptiveSlope
+    adaptiveSlopeInternal((slope * 128 + 50) / 100),
+    exponent(smoothing),
+    emaMode(mode)
+{
+}
+
+/**
+ * Updates one state exactly like SlewRateLimiter::processValue and returns the output. The EMA mode and
+ * whether the adaptive slope is applied are template parameters, and the rest is written with selects like
+ * SRL_bankUpdateChannel, so the loop over a group has no branches and can be vectorized.
+ */
+template <bool Adaptive, SlewRateLimiter::SRL_EMAMode Mode>
+static inline int SRL_groupUpdate(int rate, int band, int slope, int exponent, SRL_State& state, int currentValue)
+{
+  // The first-call sentinel only exists in the int32_t fields, so it is tested before any narrowing, and the
+  // update stays in int32_t (as in the SlewRateLimiterBank16 kernels) where int is 16 bits. On the first call
+  // the sentinel is replaced by the input before any arithmetic, so nothing overflows on the sentinel.
+  bool first = SRL_isFirstCall(state);
+  int32_t input = currentValue;
+  int32_t last = first ? input : state.lastValue;
+  int32_t ema = first ? input : state.emaValue;
+
+  int32_t scale = (int32_t)1 << exponent;
+  int32_t newEma = (Mode != SlewRateLimiter::SRL_EMA_OFF) ? (input * scale + ema * 1024 - ema * scale) >> 10 : ema;
+  int32_t target = (Mode == SlewRateLimiter::SRL_EMA_DRIVE) ? newEma : input;
+
+  int32_t delta = target - last;
+  int32_t absDelta = delta < 0 ? -delta : delta;
+  int32_t allowedChange = Adaptive ? rate + ((absDelta * slope)>>7) : (int32_t)rate;
+
+  // Rate limiting
+  int32_t limited = (delta > allowedChange) ? last + allowedChange
+                  : (delta < -allowedChange) ? last - allowedChange
+                  : target;
+
+  // Apply hysteresis
+  int32_t remaining = target - limited;
+  limited = ((remaining < 0 ? -remaining : remaining) <= band) ? target : limited;
+
+  // The first value of a channel is passed straight through
+  state.lastValue = first ? input : limited;
+  state.emaValue = first ? input : newEma;
+  return (int)state.lastValue;
+}
+
+SlewRateLimiterGroup::SlewRateLimiterGroup(const SRL_Config& sharedConfig, size_t channels)
+  : config(sharedConfig),
+    states(new SRL_State[channels]),
+    channelCount(channels)
+{
+  reset();
+}
+
+SlewRateLimiterGroup::~SlewRateLimiterGroup()
+{
+  delete[] states;
+}
+
+size_t SlewRateLimiterGroup::size() const
+{
+  return channelCount;
+}
+
+template <bool Adaptive, SlewRateLimiter::SRL_EMAMode Mode>
+void SlewRateLimiterGroup::processLoop(const int* inputs, int* outputs)
+{
+  // The configuration is read once; the states are the only per-channel memory traffic
+  const int rate = config.rateLimit;
+  const int band = config.hysteresisBand;
+  const int slope = config.adaptiveSlopeInternal;
+  const int exponent = config.exponent;
+  for (size_t c = 0; c < channelCount; c++)
+  {
+    outputs[c] = SRL_groupUpdate<Adaptive, Mode>(rate, band, slope, exponent, states[c], inputs[c]);
+  }
+}
+
+void SlewRateLimiterGroup::processAll(const int* inputs, int* outputs)
+{
+  bool adaptive = config.adaptiveSlopeInternal != 0;
+  switch (config.emaMode)
+  {
+    case SlewRateLimiter::SRL_EMA_OFF:
+      adaptive ? processLoop<true, SlewRateLimiter::SRL_EMA_OFF>(inputs, outputs)
+               : processLoop<false, SlewRateLimiter::SRL_EMA_OFF>(inputs, outputs);
+      break;
+    case SlewRateLimiter::SRL_EMA_DRIVE:
+      adaptive ? processLoop<true, SlewRateLimiter::SRL_EMA_DRIVE>(inputs, outputs)
+               : processLoop<false, SlewRateLimiter::SRL_EMA_DRIVE>(inputs, outputs);
+      break;
+    default:
+      adaptive ? processLoop<true, SlewRateLimiter::SRL_EMA_TRACK>(inputs, outputs)
+               : processLoop<false, SlewRateLimiter::SRL_EMA_TRACK>(inputs, outputs);
+      break;
+  }
+}
+
+int SlewRateLimiterGroup::processValue(size_t channel, int currentValue)
+{
+  // A zero slope adds nothing, so a single channel does not need the adaptive specialization
+  const SRL_Config& c = config;
+  switch (c.emaMode)
+  {
+    case SlewRateLimiter::SRL_EMA_OFF:
+      return SRL_groupUpdate<true, SlewRateLimiter::SRL_EMA_OFF>(c.rateLimit, c.hysteresisBand,
+          c.adaptiveSlopeInternal, c.exponent, states[channel], currentValue);
+    case SlewRateLimiter::SRL_EMA_DRIVE:
+      return SRL_groupUpdate<true, SlewRateLimiter::SRL_EMA_DRIVE>(c.rateLimit, c.hysteresisBand,
+          c.adaptiveSlopeInternal, c.exponent, states[channel], currentValue);
+    default:
+      return SRL_groupUpdate<true, SlewRateLimiter::SRL_EMA_TRACK>(c.rateLimit, c.hysteresisBand,
+          c.adaptiveSlopeInternal, c.exponent, states[channel], currentValue);
+  }
+}
+
+int SlewRateLimiterGroup::getValue(size_t channel) const
+{
+  // A channel in the first-call state reads as 0, like a fresh SlewRateLimiter
+  return SRL_isFirstCall(states[channel]) ? 0 : states[channel].lastValue;
+}
+
+int SlewRateLimiterGroup::getEMA(size_t channel) const
+{
+  return SRL_isFirstCall(states[channel]) ? 0 : states[channel].emaValue;
+}
+
+const SRL_Config& SlewRateLimiterGroup::getConfig() const
+{
+  return config;
+}
+
+void SlewRateLimiterGroup::getStates(SRL_State* out) const
+{
+  memcpy(out, states, channelCount * sizeof(SRL_State));
+}
+
+void SlewRateLimiterGroup::setStates(const SRL_State* in)
+{
+  memcpy(states, in, channelCount * sizeof(SRL_State));
+}
+
+void SlewRateLimiterGroup::reset(size_t channel)
+{
+  states[channel] = SRL_initialState();
+}
+
+void SlewRateLimiterGroup::reset()
+{
+  for (size_t c = 0; c < channelCount; c++)
+  {
+    states[c] = SRL_initialState();
+  }
+}
@@ -0,0 +1,88 @@
+/**
+ * @file SlewRateLimiterGroup.h
+ * @brief A group of slew rate limiter channels that share one immutable configuration.
+ *
+ * A SlewRateLimiter instance stores its configuration (rate limit, hysteresis band, adaptive slope, exponent,
+ * EMA mode) next to its state, ~32 bytes per instance, although large installations typically have a
+ * handful of configurations for hundreds of thousands of channels. The flyweight split keeps:
+ * - SRL_Config: One immutable configuration, built once and copied into any number of groups.
+ * - SRL_State: The 8-byte per-channel state (SlewRateLimiterState.h).
+ * - SlewRateLimiterGroup: An array of SRL_State processed with one SRL_Config, so 500k channels take 4 MB.
+ *
+ * Every channel is bit-exact with a SlewRateLimiter with the same configuration. Channels with different
+ * configurations go into different groups.
+ *
+ * Major methods:
+ * - processAll: Processes one input value per channel and writes one output value per channel.
+ * - processValue: Processes one input value on one channel.
+ * - getValue, getEMA: Return the last output value or the EMA of a channel.
+ * - getConfig: The shared configuration.
+ * - getStates, setStates: Bulk snapshot and restore of every channel's state, as SlewRateLimiterBank.
+ * - reset: Resets one channel, or every channel.
+ *
+ * Major variables:
+ * - config: The group's own copy of the configuration, so the SRL_Config it was built from can be a temporary.
+ * - states: The per-channel states.
+ *
+ * @note The configuration is immutable: to change it, build a new SRL_Config and move the channels to a group
+ *       that uses it (their SRL_State can be copied as is).
+ */
+
+#ifndef SlewRateLimiterGroup_h
+#define SlewRateLimiterGroup_h
+
+#include "SlewRateLimiter.h"
+#include "SlewRateLimiterState.h"
+
+/**
+ * The configuration shared by the channels of a group, in the internal units of SlewRateLimiter. The fields are
+ * const: a configuration is fixed when it is built.
+ */
+struct SRL_Config
+{
+    explicit SRL_Config(
+        SlewRateLimiter::SRL_SmoothingExponent smoothing = SlewRateLimiter::SRL_SMOOTHING_4, 
+        int rate = 5, 
+        int hystBand = 2,
+        int slope = 0,
+        SlewRateLimiter::SRL_EMAMode mode = SlewRateLimiter::SRL_EMA_TRACK
+    );
+
+    const int rateLimit;
+    const int hysteresisBand;
+    const int adaptiveSlopeInternal;
+    const SlewRateLimiter::SRL_SmoothingExponent exponent;
+    const SlewRateLimiter::SRL_EMAMode emaMode;
+};
+
+class SlewRateLimiterGroup 
+{
+public:
+    SlewRateLimiterGroup(const SRL_Config& sharedConfig, size_t channels);
+    ~SlewRateLimiterGroup();
+
+    size_t size() const;
+    void processAll(const int* inputs, int* outputs);
+    int processValue(size_t channel, int currentValue);
+    int getValue(size_t channel) const;
+    int getEMA(size_t channel) const;
+    const SRL_Config& getConfig() const;
+    void getStates(SRL_State* out) const;
+    void setStates(const SRL_State* in);
+    void reset(size_t channel);
+    void reset();
+
+private:
+    // Not copyable: the group owns its states
+    SlewRateLimiterGroup(const SlewRateLimiterGroup&);
+    SlewRateLimiterGroup& operator=(const SlewRateLimiterGroup&);
+
+    template <bool Adaptive, SlewRateLimiter::SRL_EMAMode Mode>
+    void processLoop(const int* inputs, int* outputs);
+
+    const SRL_Config config;
+    SRL_State* states;
+    size_t channelCount;
+};
+
+#endif /* SlewRateLimiterGroup_h */
@@ -0,0 +1,477 @@
+/**
+ * @file SlewRateLimiterImpl.h
+ * @brief Implements the SlewRateLimiter class, providing both fixed and adaptive slew rate control.
+ *
+ * This implementation of the SlewRateLimiter class allows for precise control over the rate at which a 
+ * signal can change, also known as its slew rate. By smoothing input signals and limiting their rate of 
+ * change, the library helps prevent abrupt signal changes that could lead to undesirable effects in physical 
+ * systems, such as mechanical stress, overshooting in control systems, or audible clicks in audio systems.
+ *
+ * The adaptive mode allows the slew rate to increase with larger signal deviations, making the system more 
+ * responsive during rapid changes while still preventing excessively fast transitions. The library uses an 
+ * Exponential Moving Average (EMA) to smooth the input signal and provides a hysteresis mechanism to avoid 
+ * unnecessary adjustments for small fluctuations, which is particularly useful for noisy signals.
+ *
+ * Methods:
+ * - initEMA, updateEMA, emaOutput: Internal methods to start, update and read the EMA (classic int EMA, or the
+ *   wide accumulator of SlewRateLimiterEMA.h when SRL_WIDE_EMA is defined).
+ * - processValue: Applies rate limiting to an input value based on the current configuration.
+ * - processBlock: Applies processValue to a whole buffer, keeping the state in locals for the loop.
+ * - advance, advanceOutput: Fast-forward over a run of identical input values. The fixed-rate ramp is computed
+ *   in closed form; the EMA and the adaptive slope are stepped until they stop changing.
+ * - isSettled, ticksToSettle, settledOn: Convergence queries. ticksToSettle is closed-form for a fixed rate
+ *   and simulates a copy of the limiter with the adaptive slope or in drive mode.
+ * - processValueAt: Applies rate limiting with the allowed change scaled by the time since the previous call.
+ * - limitValue: Internal method with the EMA, adaptive slope, rate limiting and hysteresis steps shared by
+ *   processValue and processValueAt. The adaptive slope, rate limiting and hysteresis are SRL_limitStep
+ *   (SlewRateLimiterStep.h), which StaticSlewRateLimiter shares.
+ * - setEMAMode: Selects whether the EMA is tracked, drives the limiter, or is skipped.
+ * - getValue: Returns the last output value.
+ * - getEMA: Returns the current EMA value.
+ * - getState, setState: Snapshot and restore lastValue, emaValue and isFirstCall as an SRL_State.
+ * - setRateLimit: Configures the maximum rate of change allowed in fixed mode.
+ * - setRateLimitPerSecond: Configures the maximum rate of change used by processValueAt.
+ * - setHysteresisBand: Defines the range within which the output will not change, to prevent noise.
+ * - setSmoothingExponent: Adjusts the weight of new input values in the EMA calculation.
+ * - setAdaptiveSlope: Determines how much the slew rate increases with larger input deviations.
+ * - reset: Reinitializes the internal state, clearing the EMA and last output value.
+ *
+ * The implementation is optimized for microcontrollers, using efficient algorithms and avoiding floating-point 
+ * arithmetic to ensure it can run on low-resource hardware platforms like the Arduino.
+ *
+ * The definitions live in this header so they can be compiled either out of line, by SlewRateLimiter.cpp, or
+ * inline in every translation unit when SRL_HEADER_ONLY is defined (see SlewRateLimiter.h). SRL_INLINE expands
+ * to "inline" in the header-only configuration and to nothing otherwise.
+ *
+ * @author  Andrew McKinnon
+ * @date    2023-11-3
+ */
+
+
+#ifndef SlewRateLimiterImpl_h
+#define SlewRateLimiterImpl_h
+
+#include "SlewRateLimiter.h"
+
+SRL_INLINE SlewRateLimiter::SlewRateLimiter(
+    SRL_SmoothingExponent exponent, 
+    int rate, 
+    int hystBand, 
+    int slope,
+    SRL_EMAMode mode
+)
+  : lastValue(0),
+    lastInput(0),
+    emaValue(0),
+    isFirstCall(true),
+    clockStarted(false),
+    emaMode(mode),
+    currentExponent(exponent),
+    rateLimit(rate),
+    hysteresisBand(hystBand),
+    adaptiveSlopeInternal(0),
+    ratePerMicroWhole(0),
+    ratePerMicroFraction(0),
+    rateCarry(0),
+    lastTimestamp(0)
+{
+  setAdaptiveSlope(slope);
+}
+
+inline SlewRateLimiter::EMAStorage SlewRateLimiter::initEMA(int value)
+{
+#ifdef SRL_WIDE_EMA
+    return SRL_WideEMA<int>::init(value);
+#else
+    return value;
+#endif
+}
+
+inline SlewRateLimiter::EMAStorage SlewRateLimiter::updateEMA(int newValue, EMAStorage currentEMA, SRL_SmoothingExponent smoothingExponent) 
+{
+#ifdef SRL_WIDE_EMA
+    return SRL_WideEMA<int>::update(newValue, currentEMA, smoothingExponent);
+#else
+    // Efficient EMA calculation using powers of 2. The multiplications compile to the same left shifts,
+    // but unlike '<<' they are defined for negative values.
+    int scale = 1 << smoothingExponent;
+    return (newValue * scale + currentEMA * 1024 - currentEMA * scale) >> 10;
+#endif
+}
+
+inline int SlewRateLimiter::emaOutput(EMAStorage ema)
+{
+#ifdef SRL_WIDE_EMA
+    return SRL_WideEMA<int>::output(ema);
+#else
+    return ema;
+#endif
+}
+
+SRL_INLINE int SlewRateLimiter::processValue(int currentValue)
+{
+  if (isFirstCall)
+  {
+    lastValue = currentValue;
+    lastInput = currentValue;
+    emaValue = initEMA(currentValue);
+    isFirstCall = false;
+    return currentValue;
+  }
+
+  return limitValue(currentValue, rateLimit);
+}
+
+SRL_INLINE int SlewRateLimiter::advance(int currentValue, unsigned long n)
+{
+  if (n == 0)
+  {
+    return lastValue;
+  }
+  if (isFirstCall)
+  {
+    processValue(currentValue);
+    n--;
+  }
+  lastInput = currentValue;
+
+  // The EMA has no exact closed form (every update truncates), but with a constant input it reaches a fixed
+  // point after a bounded number of samples (a few thousand at most, with SRL_SMOOTHING_1), after which
+  // every further update returns the same value.
+  if (emaMode == SRL_EMA_DRIVE)
+  {
+    // The EMA is the target: step the whole limiter until the EMA has settled
+    for (; n > 0; n--)
+    {
+      if (updateEMA(currentValue, emaValue, currentExponent) == emaValue)
+      {
+        break;
+      }
+      limitValue(currentValue, rateLimit);
+    }
+    advanceOutput(emaOutput(emaValue), n);
+    return lastValue;
+  }
+
+  if (emaMode == SRL_EMA_TRACK)
+  {
+    // The EMA does not affect the output, so it is stepped on its own
+    for (unsigned long k = 0; k < n; k++)
+    {
+      EMAStorage next = updateEMA(currentValue, emaValue, currentExponent);
+      if (next == emaValue)
+      {
+        break;
+      }
+      emaValue = next;
+    }
+  }
+
+  advanceOutput(currentValue, n);
+  return lastValue;
+}
+
+inline void SlewRateLimiter::advanceOutput(int target, unsigned long n)
+{
+  if (n == 0)
+  {
+    return;
+  }
+
+  if (adaptiveSlopeInternal == 0 && rateLimit > 0)
+  {
+    // Fixed rate: the output ramps by rateLimit per sample and lands on the target at the first sample k
+    // where |target - lastValue| - k * rateLimit <= band (or <= 0, without hysteresis)
+    int distance = abs(target - lastValue);
+    int band = (hysteresisBand > 0) ? hysteresisBand : 0;
+    unsigned long needed = (distance <= band) ? 1 : (unsigned long)((distance - band - 1) / rateLimit) + 1;
+    if (n >= needed)
+    {
+      lastValue = target;
+    }
+    else
+    {
+      // n < needed, so n * rateLimit < distance
+      int change = (int)n * rateLimit;
+      lastValue += (target > lastValue) ? change : -change;
+    }
+    return;
+  }
+
+  // Adaptive slope, or no fixed rate: step until the output stops changing
+  for (; n > 0; n--)
+  {
+    int next = SRL_limitStep<true, true>(target, lastValue, rateLimit, hysteresisBand, adaptiveSlopeInternal);
+    if (next == lastValue)
+    {
+      break;
+    }
+    lastValue = next;
+  }
+}
+
+inline bool SlewRateLimiter::settledOn(int input) const
+{
+  if (emaMode == SRL_EMA_DRIVE)
+  {
+    // The target is the EMA, which must have reached its fixed point for this input
+    return updateEMA(input, emaValue, currentExponent) == emaValue && lastValue == emaOutput(emaValue);
+  }
+  return lastValue == input;
+}
+
+SRL_INLINE bool SlewRateLimiter::isSettled() const
+{
+  // Within the hysteresis band processValue snaps onto the target, so settled means equal
+  return !isFirstCall && settledOn(lastInput);
+}
+
+SRL_INLINE unsigned long SlewRateLimiter::ticksToSettle(int target) const
+{
+  if (isFirstCall)
+  {
+    return 1;
+  }
+  if (settledOn(target))
+  {
+    return 0;
+  }
+
+  if (emaMode != SRL_EMA_DRIVE && adaptiveSlopeInternal == 0)
+  {
+    // Fixed rate: the same landing sample as advanceOutput
+    int distance = abs(target - lastValue);
+    int band = (hysteresisBand > 0) ? hysteresisBand : 0;
+    if (distance <= band)
+    {
+      return 1;
+    }
+    if (rateLimit <= 0)
+    {
+      return SRL_NEVER_SETTLES;
+    }
+    return (unsigned long)((distance - band - 1) / rateLimit) + 1;
+  }
+
+  // Adaptive slope or drive mode: step a copy. Every step changes the output or, in drive mode, the EMA
+  // (which settles after a bounded number of samples); a step that changes neither never will.
+  SlewRateLimiter copy(*this);
+  unsigned long ticks = 0;
+  while (!copy.settledOn(target))
+  {
+    int before = copy.lastValue;
+    EMAStorage emaBefore = copy.emaValue;
+    copy.processValue(target);
+    ticks++;
+    if (copy.lastValue == before && (emaMode != SRL_EMA_DRIVE || copy.emaValue == emaBefore))
+    {
+      return SRL_NEVER_SETTLES;
+    }
+  }
+  return ticks;
+}
+
+SRL_INLINE int SlewRateLimiter::processValueAt(int currentValue, unsigned long timestampMicros)
+{
+  // Only the low 32 bits are used, so the difference is right across a micros() wrap-around. The first call
+  // after a restored state starts the clock: no time has elapsed on it yet.
+  uint32_t elapsed = clockStarted ? (uint32_t)timestampMicros - (uint32_t)lastTimestamp : 0;
+  lastTimestamp = timestampMicros;
+  clockStarted = true;
+  if (isFirstCall)
+  {
+    rateCarry = 0;
+    return processValue(currentValue);
+  }
+
+  // elapsed * rate in 32.32 fixed point, no division; the unused fraction of a unit is carried over, so
+  // slow rates are exact over time however the calls are spaced. On AVR this avoids 64-bit multiplies for
+  // calls less than 65 ms apart (see SRL_scaleRate32).
+  uint32_t allowedChange = SRL_scaleRate(elapsed, ratePerMicroWhole, ratePerMicroFraction, rateCarry);
+
+  return limitValue(currentValue, (allowedChange > (uint32_t)INT_MAX) ? INT_MAX : (int)allowedChange);
+}
+
+inline int SlewRateLimiter::limitValue(int currentValue, int rate)
+{
+  lastInput = currentValue;
+  int target = currentValue;
+  if (emaMode != SRL_EMA_OFF)
+  {
+    emaValue = updateEMA(currentValue, emaValue, currentExponent);
+
+    // In drive mode the smoothed signal is limited instead of the raw input
+    if (emaMode == SRL_EMA_DRIVE)
+    {
+      target = emaOutput(emaValue);
+    }
+  }
+
+#ifdef SRL_BRANCHLESS
+  // A zero adaptive slope adds nothing, so the term needs no branch
+  lastValue = SRL_limitStep<true, true>(target, lastValue, rate, hysteresisBand, adaptiveSlopeInternal);
+#else
+  // Implement adaptive slope if applicable
+  if (adaptiveSlopeInternal != 0)
+  {
+    lastValue = SRL_limitStep<true, true>(target, lastValue, rate, hysteresisBand, adaptiveSlopeInternal);
+  }
+  else
+  {
+    lastValue = SRL_limitStep<false, true>(target, lastValue, rate, hysteresisBand, 0);
+  }
+#endif
+
+  return lastValue;
+}
+
+template <bool Adaptive, SlewRateLimiter::SRL_EMAMode Mode>
+SRL_INLINE void SlewRateLimiter::processBlockLoop(const int* in, int* out, size_t begin, size_t n)
+{
+  // Work on local copies so the state stays in registers for the whole buffer;
+  // writes through 'out' could otherwise alias the members.
+  int last = lastValue;
+  EMAStorage ema = emaValue;
+  const SRL_SmoothingExponent exponent = currentExponent;
+  const int rate = rateLimit;
+  const int band = hysteresisBand;
+  const int slope = adaptiveSlopeInternal;
+  // Read before the loop: with in == out, in[n - 1] is overwritten by the last output
+  const int finalInput = in[n - 1];
+
+  for (size_t i = begin; i < n; i++)
+  {
+    int target = in[i];
+    if (Mode != SRL_EMA_OFF)
+    {
+      ema = updateEMA(target, ema, exponent);
+      if (Mode == SRL_EMA_DRIVE)
+      {
+        target = emaOutput(ema);
+      }
+    }
+
+    last = SRL_limitStep<Adaptive, true>(target, last, rate, band, slope);
+    out[i] = last;
+  }
+
+  lastValue = last;
+  lastInput = finalInput;
+  emaValue = ema;
+}
+
+SRL_INLINE void SlewRateLimiter::processBlock(const int* in, int* out, size_t n)
+{
+  if (n == 0)
+  {
+    return;
+  }
+
+  size_t i = 0;
+  if (isFirstCall)
+  {
+    out[0] = processValue(in[0]);
+    i = 1;
+  }
+
+  // Hoist the adaptive slope and EMA mode checks out of the loop
+  bool adaptive = adaptiveSlopeInternal != 0;
+  switch (emaMode)
+  {
+    case SRL_EMA_OFF:
+      adaptive ? processBlockLoop<true, SRL_EMA_OFF>(in, out, i, n)
+               : processBlockLoop<false, SRL_EMA_OFF>(in, out, i, n);
+      break;
+    case SRL_EMA_DRIVE:
+      adaptive ? processBlockLoop<true, SRL_EMA_DRIVE>(in, out, i, n)
+               : processBlockLoop<false, SRL_EMA_DRIVE>(in, out, i, n);
+      break;
+    default:
+      adaptive ? processBlockLoop<true, SRL_EMA_TRACK>(in, out, i, n)
+               : processBlockLoop<false, SRL_EMA_TRACK>(in, out, i, n);
+      break;
+  }
+}
+
+SRL_INLINE void SlewRateLimiter::setRateLimit(int limit) 
+{
+    rateLimit = limit;
+}
+
+SRL_INLINE void SlewRateLimiter::setRateLimitPerSecond(unsigned long unitsPerSecond) 
+{
+    // Units per microsecond in 32.32 fixed point, the fraction rounded to the nearest 2^-32
+    uint64_t whole = (uint64_t)unitsPerSecond / 1000000;
+    ratePerMicroWhole = (whole > 0xFFFFFFFFUL) ? 0xFFFFFFFFUL : (uint32_t)whole;
+    ratePerMicroFraction = (uint32_t)((((uint64_t)(unitsPerSecond % 1000000UL) << 32) + 500000) / 1000000);
+}
+
+SRL_INLINE void SlewRateLimiter::setHysteresisBand(int band) 
+{
+    hysteresisBand = band;
+}
+
+SRL_INLINE void SlewRateLimiter::setSmoothingExponent(SRL_SmoothingExponent exponent) 
+{
+    currentExponent = exponent;
+}
+
+SRL_INLINE void SlewRateLimiter::setAdaptiveSlope(int slope) 
+{
+    // Convert the slope from a percentage to a scale of 128 for efficient calculation
+    adaptiveSlopeInternal = (slope * 128 + 50) / 100; // The "+ 50" is for rounding to the nearest integer
+}
+
+SRL_INLINE void SlewRateLimiter::setEMAMode(SRL_EMAMode mode) 
+{
+    emaMode = mode;
+}
+
+SRL_INLINE int SlewRateLimiter::getValue() const
+{
+    return lastValue;
+}
+
+SRL_INLINE int SlewRateLimiter::getEMA() const
+{
+    return emaOutput(emaValue);
+}
+
+SRL_INLINE SRL_State SlewRateLimiter::getState() const
+{
+  if (isFirstCall)
+  {
+    return SRL_initialState();
+  }
+
+  // With SRL_WIDE_EMA only the integer part of the EMA fits in the snapshot; the fraction restarts at zero
+  SRL_State state = { (int32_t)lastValue, (int32_t)emaOutput(emaValue) };
+  return state;
+}
+
+SRL_INLINE void SlewRateLimiter::setState(const SRL_State& state)
+{
+  reset();
+  if (SRL_isFirstCall(state))
+  {
+    return;
+  }
+
+  // The last input is not part of the snapshot: the restored limiter counts as settled on its output
+  isFirstCall = false;
+  lastValue = (int)state.lastValue;
+  lastInput = lastValue;
+  emaValue = initEMA((int)state.emaValue);
+}
+
+SRL_INLINE void SlewRateLimiter::reset() 
+{
+    isFirstCall = true;
+    clockStarted = false;
+    lastValue = 0;
+    lastInput = 0;
+    emaValue = 0;
+    rateCarry = 0;
+}
+
+#endif /* SlewRateLimiterImpl_h */
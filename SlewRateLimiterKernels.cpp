@@ -0,0 +1,590 @@
+/**
+ * @file SlewRateLimiterKernels.cpp
+ * @brief Implements the scalar and x86 SIMD bank update kernels.
+ *
+ * The SIMD kernels replace every branch of processValue with lane masks:
+ * - EMA: the shifts by the per-channel exponent become a variable shift (AVX2), or a multiply by 2^exponent
+ *   built from the exponent bits of a float (SSE4.1, which has no per-lane shift). Both wrap exactly like
+ *   the scalar shifts.
+ * - Adaptive slope: always computed, since a zero slope adds nothing.
+ * - Rate limiting: the current value is blended with last - allowedChange, then last + allowedChange,
+ *   so the "greater than" case wins when both compares are true, as in the scalar if/else chain.
+ * - Hysteresis and first call: a final blend back to the target (hysteresis) or the input (first call).
+ * - EMA mode: tested once per vector; the branch is loop-invariant and always predicted.
+ *
+ * The dispatcher probes the CPU once (CPUID through __builtin_cpu_supports, which also checks that the OS
+ * saves the wide registers) and routes every bank tick to the widest supported kernel.
+ */
+
+
+#include "SlewRateLimiterKernels.h"
+
+#ifdef SRL_HAVE_X86_KERNELS
+#include <immintrin.h>
+#include <string.h>
+#endif
+
+void SRL_bankKernelScalar(const SRL_BankArrays& arrays, const int* inputs, int* outputs, size_t begin, size_t end)
+{
+  const bool emaOn = arrays.emaMode != SlewRateLimiter::SRL_EMA_OFF;
+  const bool drive = arrays.emaMode == SlewRateLimiter::SRL_EMA_DRIVE;
+
+  for (size_t c = begin; c < end; c++)
+  {
+    SRL_bankUpdateChannel(arrays, inputs, outputs, c, emaOn, drive);
+  }
+}
+
+#ifdef SRL_HAVE_X86_KERNELS
+
+__attribute__((target("sse4.1")))
+size_t SRL_bankKernelSSE41(const SRL_BankArrays& arrays, const int* inputs, int* outputs, size_t count)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const bool emaOn = arrays.emaMode != SlewRateLimiter::SRL_EMA_OFF;
+  const bool drive = arrays.emaMode == SlewRateLimiter::SRL_EMA_DRIVE;
+  const __m128i floatBias = _mm_set1_epi32(127);
+  size_t c = 0;
+
+  for (; c + 4 <= count; c += 4)
+  {
+    __m128i x = _mm_loadu_si128((const __m128i*)(inputs + c));
+    __m128i last = _mm_loadu_si128((const __m128i*)(arrays.lastValue + c));
+    __m128i ema = _mm_loadu_si128((const __m128i*)(arrays.emaValue + c));
+    __m128i rate = _mm_loadu_si128((const __m128i*)(arrays.rateLimit + c));
+    __m128i band = _mm_loadu_si128((const __m128i*)(arrays.hysteresisBand + c));
+    __m128i slope = _mm_loadu_si128((const __m128i*)(arrays.adaptiveSlopeInternal + c));
+
+    int packed;
+    memcpy(&packed, arrays.smoothingExponent + c, sizeof(packed));
+    __m128i exponent = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed));
+    memcpy(&packed, arrays.firstCall + c, sizeof(packed));
+    __m128i notFirst = _mm_cmpeq_epi32(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed)), zero);
+
+    __m128i newEma = ema;
+    if (emaOn)
+    {
+      // 2^exponent, read back from a float whose exponent field is exponent + 127
+      __m128i scale = _mm_cvttps_epi32(_mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(exponent, floatBias), 23)));
+      newEma = _mm_srai_epi32(
+          _mm_sub_epi32(_mm_add_epi32(_mm_mullo_epi32(x, scale), _mm_slli_epi32(ema, 10)), _mm_mullo_epi32(ema, scale)),
+          10);
+    }
+    __m128i target = drive ? newEma : x;
+
+    __m128i delta = _mm_sub_epi32(target, last);
+    __m128i allowedChange = _mm_add_epi32(rate, _mm_srai_epi32(_mm_mullo_epi32(_mm_abs_epi32(delta), slope), 7));
+
+    __m128i above = _mm_cmpgt_epi32(delta, allowedChange);
+    __m128i below = _mm_cmpgt_epi32(_mm_sub_epi32(zero, allowedChange), delta);
+    __m128i limited = _mm_blendv_epi8(target, _mm_sub_epi32(last, allowedChange), below);
+    limited = _mm_blendv_epi8(limited, _mm_add_epi32(last, allowedChange), above);
+
+    __m128i outsideBand = _mm_cmpgt_epi32(_mm_abs_epi32(_mm_sub_epi32(target, limited)), band);
+    limited = _mm_blendv_epi8(target, limited, outsideBand);
+    limited = _mm_blendv_epi8(x, limited, notFirst);
+    newEma = _mm_blendv_epi8(x, newEma, notFirst);
+
+    _mm_storeu_si128((__m128i*)(arrays.lastValue + c), limited);
+    _mm_storeu_si128((__m128i*)(arrays.emaValue + c), newEma);
+    _mm_storeu_si128((__m128i*)(outputs + c), limited);
+    memset(arrays.firstCall + c, 0, 4);
+  }
+
+  return c;
+}
+
+__attribute__((target("avx2")))
+size_t SRL_bankKernelAVX2(const SRL_BankArrays& arrays, const int* inputs, int* outputs, size_t count)
+{
+  const __m256i zero = _mm256_setzero_si256();
+  const bool emaOn = arrays.emaMode != SlewRateLimiter::SRL_EMA_OFF;
+  const bool drive = arrays.emaMode == SlewRateLimiter::SRL_EMA_DRIVE;
+  size_t c = 0;
+
+  for (; c + 8 <= count; c += 8)
+  {
+    __m256i x = _mm256_loadu_si256((const __m256i*)(inputs + c));
+    __m256i last = _mm256_loadu_si256((const __m256i*)(arrays.lastValue + c));
+    __m256i ema = _mm256_loadu_si256((const __m256i*)(arrays.emaValue + c));
+    __m256i rate = _mm256_loadu_si256((const __m256i*)(arrays.rateLimit + c));
+    __m256i band = _mm256_loadu_si256((const __m256i*)(arrays.hysteresisBand + c));
+    __m256i slope = _mm256_loadu_si256((const __m256i*)(arrays.adaptiveSlopeInternal + c));
+    __m256i exponent = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(arrays.smoothingExponent + c)));
+    __m256i notFirst = _mm256_cmpeq_epi32(
+        _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(arrays.firstCall + c))), zero);
+
+    __m256i newEma = ema;
+    if (emaOn)
+    {
+      newEma = _mm256_srai_epi32(
+          _mm256_sub_epi32(_mm256_add_epi32(_mm256_sllv_epi32(x, exponent), _mm256_slli_epi32(ema, 10)),
+                           _mm256_sllv_epi32(ema, exponent)),
+          10);
+    }
+    __m256i target = drive ? newEma : x;
+
+    __m256i delta = _mm256_sub_epi32(target, last);
+    __m256i allowedChange = _mm256_add_epi32(rate,
+        _mm256_srai_epi32(_mm256_mullo_epi32(_mm256_abs_epi32(delta), slope), 7));
+
+    __m256i above = _mm256_cmpgt_epi32(delta, allowedChange);
+    __m256i below = _mm256_cmpgt_epi32(_mm256_sub_epi32(zero, allowedChange), delta);
+    __m256i limited = _mm256_blendv_epi8(target, _mm256_sub_epi32(last, allowedChange), below);
+    limited = _mm256_blendv_epi8(limited, _mm256_add_epi32(last, allowedChange), above);
+
+    __m256i outsideBand = _mm256_cmpgt_epi32(_mm256_abs_epi32(_mm256_sub_epi32(target, limited)), band);
+    limited = _mm256_blendv_epi8(target, limited, outsideBand);
+    limited = _mm256_blendv_epi8(x, limited, notFirst);
+    newEma = _mm256_blendv_epi8(x, newEma, notFirst);
+
+    _mm256_storeu_si256((__m256i*)(arrays.lastValue + c), limited);
+    _mm256_storeu_si256((__m256i*)(arrays.emaValue + c), newEma);
+    _mm256_storeu_si256((__m256i*)(outputs + c), limited);
+    memset(arrays.firstCall + c, 0, 8);
+  }
+
+  return c;
+}
+
+// GCC 12's own AVX-512 headers trip -Wmaybe-uninitialized (_mm512_undefined_epi32) when the
+// intrinsics are used through a target attribute
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+__attribute__((target("avx512f")))
+size_t SRL_bankKernelAVX512(const SRL_BankArrays& arrays, const int* inputs, int* outputs, size_t count)
+{
+  const __m512i zero = _mm512_setzero_si512();
+  const bool emaOn = arrays.emaMode != SlewRateLimiter::SRL_EMA_OFF;
+  const bool drive = arrays.emaMode == SlewRateLimiter::SRL_EMA_DRIVE;
+  size_t c = 0;
+
+  for (; c + 16 <= count; c += 16)
+  {
+    __m512i x = _mm512_loadu_si512((const void*)(inputs + c));
+    __m512i last = _mm512_loadu_si512((const void*)(arrays.lastValue + c));
+    __m512i ema = _mm512_loadu_si512((const void*)(arrays.emaValue + c));
+    __m512i rate = _mm512_loadu_si512((const void*)(arrays.rateLimit + c));
+    __m512i band = _mm512_loadu_si512((const void*)(arrays.hysteresisBand + c));
+    __m512i slope = _mm512_loadu_si512((const void*)(arrays.adaptiveSlopeInternal + c));
+    __m512i exponent = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*)(arrays.smoothingExponent + c)));
+    __mmask16 notFirst = _mm512_cmpeq_epi32_mask(
+        _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*)(arrays.firstCall + c))), zero);
+
+    __m512i newEma = ema;
+    if (emaOn)
+    {
+      newEma = _mm512_srai_epi32(
+          _mm512_sub_epi32(_mm512_add_epi32(_mm512_sllv_epi32(x, exponent), _mm512_slli_epi32(ema, 10)),
+                           _mm512_sllv_epi32(ema, exponent)),
+          10);
+    }
+    __m512i target = drive ? newEma : x;
+
+    __m512i delta = _mm512_sub_epi32(target, last);
+    __m512i allowedChange = _mm512_add_epi32(rate,
+        _mm512_srai_epi32(_mm512_mullo_epi32(_mm512_abs_epi32(delta), slope), 7));
+
+    __mmask16 above = _mm512_cmpgt_epi32_mask(delta, allowedChange);
+    __mmask16 below = _mm512_cmpgt_epi32_mask(_mm512_sub_epi32(zero, allowedChange), delta);
+    __m512i limited = _mm512_mask_blend_epi32(below, target, _mm512_sub_epi32(last, allowedChange));
+    limited = _mm512_mask_blend_epi32(above, limited, _mm512_add_epi32(last, allowedChange));
+
+    __mmask16 outsideBand = _mm512_cmpgt_epi32_mask(_mm512_abs_epi32(_mm512_sub_epi32(target, limited)), band);
+    limited = _mm512_mask_blend_epi32(outsideBand, target, limited);
+    limited = _mm512_mask_blend_epi32(notFirst, x, limited);
+    newEma = _mm512_mask_blend_epi32(notFirst, x, newEma);
+
+    _mm512_storeu_si512((void*)(arrays.lastValue + c), limited);
+    _mm512_storeu_si512((void*)(arrays.emaValue + c), newEma);
+    _mm512_storeu_si512((void*)(outputs + c), limited);
+    memset(arrays.firstCall + c, 0, 16);
+  }
+
+  return c;
+}
+
+#pragma GCC diagnostic pop
+
+#endif /* SRL_HAVE_X86_KERNELS */
+
+static SRL_Kernel probeKernel()
+{
+#ifdef SRL_HAVE_X86_KERNELS
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+  {
+    return SRL_KERNEL_AVX512;
+  }
+  if (__builtin_cpu_supports("avx2"))
+  {
+    return SRL_KERNEL_AVX2;
+  }
+  if (__builtin_cpu_supports("sse4.1"))
+  {
+    return SRL_KERNEL_SSE41;
+  }
+#endif
+  return SRL_KERNEL_SCALAR;
+}
+
+// SRL_KERNEL_AUTO until a kernel is forced
+static SRL_Kernel forcedKernel = SRL_KERNEL_AUTO;
+
+SRL_Kernel SRL_detectKernel()
+{
+  static const SRL_Kernel detected = probeKernel();
+  return detected;
+}
+
+bool SRL_forceKernel(SRL_Kernel kernel)
+{
+  // Kernels are ordered by width, so anything up to the detected one is supported
+  if (kernel > SRL_detectKernel())
+  {
+    return false;
+  }
+  forcedKernel = kernel;
+  return true;
+}
+
+SRL_Kernel SRL_activeKernel()
+{
+  return (forcedKernel != SRL_KERNEL_AUTO) ? forcedKernel : SRL_detectKernel();
+}
+
+const char* SRL_kernelName(SRL_Kernel kernel)
+{
+  switch (kernel)
+  {
+    case SRL_KERNEL_AUTO:   return "auto";
+    case SRL_KERNEL_SCALAR: return "scalar";
+    case SRL_KERNEL_SSE41:  return "sse4.1";
+    case SRL_KERNEL_AVX2:   return "avx2";
+    case SRL_KERNEL_AVX512: return "avx512";
+  }
+  return "unknown";
+}
+
+void SRL_bankKernelDispatch(const SRL_BankArrays& arrays, const int* inputs, int* outputs, size_t count)
+{
+  size_t done = 0;
+
+#ifdef SRL_HAVE_X86_KERNELS
+  switch (SRL_activeKernel())
+  {
+    case SRL_KERNEL_AVX512:
+      done = SRL_bankKernelAVX512(arrays, inputs, outputs, count);
+      break;
+    case SRL_KERNEL_AVX2:
+      done = SRL_bankKernelAVX2(arrays, inputs, outputs, count);
+      break;
+    case SRL_KERNEL_SSE41:
+      done = SRL_bankKernelSSE41(arrays, inputs, outputs, count);
+      break;
+    default:
+      break;
+  }
+#endif
+
+  SRL_bankKernelScalar(arrays, inputs, outputs, done, count);
+}
+
+/*
+ * 16-bit kernels (SlewRateLimiterBank16)
+ *
+ * The state is int16_t, but BasicSlewRateLimiter<int16_t> computes in 32 bits, so the intermediate values
+ * are kept exact without widening every lane:
+ * - EMA: widened to 32 bits for the update and packed back; the result lies between the old EMA and the
+ *   input, so it always fits.
+ * - |delta|: max - min, which is exact as an unsigned 16-bit value.
+ * - Adaptive slope: (|delta| * slope) >> 7 rebuilt from the high and low halves of the 16x16 multiply,
+ *   saturated to 65535. The allowed change is rate + that term with an unsigned saturating add; saturating
+ *   is exact here because a change of 65535 or more always reaches the target.
+ * - Rate limiting and hysteresis: the distance left after moving by the allowed change is
+ *   |delta| - allowedChange with an unsigned saturating subtract. The output is the target when that
+ *   distance is within the band (or zero), and last +/- allowedChange otherwise.
+ */
+
+void SRL_bank16KernelScalar(const SRL_Bank16Arrays& arrays, const int16_t* inputs, int16_t* outputs, size_t begin, size_t end)
+{
+  const bool emaOn = arrays.emaMode != SlewRateLimiter::SRL_EMA_OFF;
+  const bool drive = arrays.emaMode == SlewRateLimiter::SRL_EMA_DRIVE;
+
+  for (size_t c = begin; c < end; c++)
+  {
+    // 32-bit intermediates, as BasicSlewRateLimiter<int16_t> (int is 16 bits on AVR)
+    int32_t currentValue = inputs[c];
+    int32_t last = arrays.lastValue[c];
+    int32_t ema = arrays.emaValue[c];
+    int32_t scale = (int32_t)1 << arrays.smoothingExponent[c];
+
+    int32_t newEma = emaOn ? (currentValue * scale + ema * 1024 - ema * scale) >> 10 : ema;
+    int32_t target = drive ? newEma : currentValue;
+
+    int32_t delta = target - last;
+    int32_t absDelta = delta < 0 ? -delta : delta;
+    int32_t allowedChange = arrays.rateLimit[c] + ((absDelta * arrays.adaptiveSlopeInternal[c])>>7);
+
+    // Rate limiting
+    int32_t limited = (delta > allowedChange) ? last + allowedChange
+                    : (delta < -allowedChange) ? last - allowedChange
+                    : target;
+
+    // Apply hysteresis
+    int32_t remaining = target - limited;
+    limited = ((remaining < 0 ? -remaining : remaining) <= arrays.hysteresisBand[c]) ? target : limited;
+
+    // The first value of a channel is passed straight through
+    bool first = arrays.firstCall[c] != 0;
+    arrays.lastValue[c] = (int16_t)(first ? currentValue : limited);
+    arrays.emaValue[c] = (int16_t)(first ? currentValue : newEma);
+    arrays.firstCall[c] = 0;
+    outputs[c] = arrays.lastValue[c];
+  }
+}
+
+#ifdef SRL_HAVE_X86_KERNELS
+
+// 32-bit EMA update of 4 lanes, with the multiply by 2^exponent of SRL_bankKernelSSE41
+__attribute__((target("sse4.1")))
+static inline __m128i emaUpdateSSE41(__m128i x, __m128i ema, __m128i exponent)
+{
+  __m128i scale = _mm_cvttps_epi32(_mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(exponent, _mm_set1_epi32(127)), 23)));
+  return _mm_srai_epi32(
+      _mm_sub_epi32(_mm_add_epi32(_mm_mullo_epi32(x, scale), _mm_slli_epi32(ema, 10)), _mm_mullo_epi32(ema, scale)),
+      10);
+}
+
+__attribute__((target("sse4.1")))
+size_t SRL_bank16KernelSSE41(const SRL_Bank16Arrays& arrays, const int16_t* inputs, int16_t* outputs, size_t count)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i ones = _mm_set1_epi16(-1);
+  const bool emaOn = arrays.emaMode != SlewRateLimiter::SRL_EMA_OFF;
+  const bool drive = arrays.emaMode == SlewRateLimiter::SRL_EMA_DRIVE;
+  size_t c = 0;
+
+  for (; c + 8 <= count; c += 8)
+  {
+    __m128i x = _mm_loadu_si128((const __m128i*)(inputs + c));
+    __m128i last = _mm_loadu_si128((const __m128i*)(arrays.lastValue + c));
+    __m128i ema = _mm_loadu_si128((const __m128i*)(arrays.emaValue + c));
+    __m128i rate = _mm_loadu_si128((const __m128i*)(arrays.rateLimit + c));
+    __m128i band = _mm_loadu_si128((const __m128i*)(arrays.hysteresisBand + c));
+    __m128i slope = _mm_loadu_si128((const __m128i*)(arrays.adaptiveSlopeInternal + c));
+    __m128i notFirst = _mm_cmpeq_epi16(
+        _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*)(arrays.firstCall + c))), zero);
+
+    __m128i newEma = ema;
+    if (emaOn)
+    {
+      __m128i exponent = _mm_loadl_epi64((const __m128i*)(arrays.smoothingExponent + c));
+      __m128i low = emaUpdateSSE41(_mm_cvtepi16_epi32(x), _mm_cvtepi16_epi32(ema), _mm_cvtepu8_epi32(exponent));
+      __m128i high = emaUpdateSSE41(_mm_cvtepi16_epi32(_mm_srli_si128(x, 8)), _mm_cvtepi16_epi32(_mm_srli_si128(ema, 8)),
+                                    _mm_cvtepu8_epi32(_mm_srli_si128(exponent, 4)));
+      newEma = _mm_packs_epi32(low, high);
+    }
+    __m128i target = drive ? newEma : x;
+
+    __m128i absDelta = _mm_sub_epi16(_mm_max_epi16(target, last), _mm_min_epi16(target, last));
+    __m128i productHigh = _mm_mulhi_epu16(absDelta, slope);
+    __m128i adaptive = _mm_or_si128(_mm_slli_epi16(productHigh, 9), _mm_srli_epi16(_mm_mullo_epi16(absDelta, slope), 7));
+    adaptive = _mm_blendv_epi8(ones, adaptive, _mm_cmpeq_epi16(_mm_srli_epi16(productHigh, 7), zero));
+    __m128i allowedChange = _mm_adds_epu16(rate, adaptive);
+
+    __m128i remaining = _mm_subs_epu16(absDelta, allowedChange);
+    __m128i reached = _mm_cmpeq_epi16(_mm_subs_epu16(remaining, _mm_max_epi16(band, zero)), zero);
+    __m128i limited = _mm_blendv_epi8(_mm_sub_epi16(last, allowedChange), _mm_add_epi16(last, allowedChange),
+                                      _mm_cmpgt_epi16(target, last));
+    limited = _mm_blendv_epi8(limited, target, reached);
+    limited = _mm_blendv_epi8(x, limited, notFirst);
+    newEma = _mm_blendv_epi8(x, newEma, notFirst);
+
+    _mm_storeu_si128((__m128i*)(arrays.lastValue + c), limited);
+    _mm_storeu_si128((__m128i*)(arrays.emaValue + c), newEma);
+    _mm_storeu_si128((__m128i*)(outputs + c), limited);
+    memset(arrays.firstCall + c, 0, 8);
+  }
+
+  return c;
+}
+
+// 32-bit EMA update of 8 lanes, as SRL_bankKernelAVX2
+__attribute__((target("avx2")))
+static inline __m256i emaUpdateAVX2(__m256i x, __m256i ema, __m256i exponent)
+{
+  return _mm256_srai_epi32(
+      _mm256_sub_epi32(_mm256_add_epi32(_mm256_sllv_epi32(x, exponent), _mm256_slli_epi32(ema, 10)),
+                       _mm256_sllv_epi32(ema, exponent)),
+      10);
+}
+
+__attribute__((target("avx2")))
+size_t SRL_bank16KernelAVX2(const SRL_Bank16Arrays& arrays, const int16_t* inputs, int16_t* outputs, size_t count)
+{
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i ones = _mm256_set1_epi16(-1);
+  const bool emaOn = arrays.emaMode != SlewRateLimiter::SRL_EMA_OFF;
+  const bool drive = arrays.emaMode == SlewRateLimiter::SRL_EMA_DRIVE;
+  size_t c = 0;
+
+  for (; c + 16 <= count; c += 16)
+  {
+    __m256i x = _mm256_loadu_si256((const __m256i*)(inputs + c));
+    __m256i last = _mm256_loadu_si256((const __m256i*)(arrays.lastValue + c));
+    __m256i ema = _mm256_loadu_si256((const __m256i*)(arrays.emaValue + c));
+    __m256i rate = _mm256_loadu_si256((const __m256i*)(arrays.rateLimit + c));
+    __m256i band = _mm256_loadu_si256((const __m256i*)(arrays.hysteresisBand + c));
+    __m256i slope = _mm256_loadu_si256((const __m256i*)(arrays.adaptiveSlopeInternal + c));
+    __m256i notFirst = _mm256_cmpeq_epi16(
+        _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(arrays.firstCall + c))), zero);
+
+    __m256i newEma = ema;
+    if (emaOn)
+    {
+      __m128i exponent = _mm_loadu_si128((const __m128i*)(arrays.smoothingExponent + c));
+      __m256i low = emaUpdateAVX2(_mm256_cvtepi16_epi32(_mm256_castsi256_si128(x)),
+                                  _mm256_cvtepi16_epi32(_mm256_castsi256_si128(ema)), _mm256_cvtepu8_epi32(exponent));
+      __m256i high = emaUpdateAVX2(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(x, 1)),
+                                   _mm256_cvtepi16_epi32(_mm256_extracti128_si256(ema, 1)),
+                                   _mm256_cvtepu8_epi32(_mm_srli_si128(exponent, 8)));
+      // packs works within 128-bit halves; the permute restores the channel order
+      newEma = _mm256_permute4x64_epi64(_mm256_packs_epi32(low, high), 0xD8);
+    }
+    __m256i target = drive ? newEma : x;
+
+    __m256i absDelta = _mm256_sub_epi16(_mm256_max_epi16(target, last), _mm256_min_epi16(target, last));
+    __m256i productHigh = _mm256_mulhi_epu16(absDelta, slope);
+    __m256i adaptive = _mm256_or_si256(_mm256_slli_epi16(productHigh, 9),
+                                       _mm256_srli_epi16(_mm256_mullo_epi16(absDelta, slope), 7));
+    adaptive = _mm256_blendv_epi8(ones, adaptive, _mm256_cmpeq_epi16(_mm256_srli_epi16(productHigh, 7), zero));
+    __m256i allowedChange = _mm256_adds_epu16(rate, adaptive);
+
+    __m256i remaining = _mm256_subs_epu16(absDelta, allowedChange);
+    __m256i reached = _mm256_cmpeq_epi16(_mm256_subs_epu16(remaining, _mm256_max_epi16(band, zero)), zero);
+    __m256i limited = _mm256_blendv_epi8(_mm256_sub_epi16(last, allowedChange), _mm256_add_epi16(last, allowedChange),
+                                         _mm256_cmpgt_epi16(target, last));
+    limited = _mm256_blendv_epi8(limited, target, reached);
+    limited = _mm256_blendv_epi8(x, limited, notFirst);
+    newEma = _mm256_blendv_epi8(x, newEma, notFirst);
+
+    _mm256_storeu_si256((__m256i*)(arrays.lastValue + c), limited);
+    _mm256_storeu_si256((__m256i*)(arrays.emaValue + c), newEma);
+    _mm256_storeu_si256((__m256i*)(outputs + c), limited);
+    memset(arrays.firstCall + c, 0, 16);
+  }
+
+  return c;
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+// 32-bit EMA update of 16 lanes, as SRL_bankKernelAVX512
+__attribute__((target("avx512bw")))
+static inline __m512i emaUpdateAVX512(__m512i x, __m512i ema, __m512i exponent)
+{
+  return _mm512_srai_epi32(
+      _mm512_sub_epi32(_mm512_add_epi32(_mm512_sllv_epi32(x, exponent), _mm512_slli_epi32(ema, 10)),
+                       _mm512_sllv_epi32(ema, exponent)),
+      10);
+}
+
+__attribute__((target("avx512bw")))
+size_t SRL_bank16KernelAVX512BW(const SRL_Bank16Arrays& arrays, const int16_t* inputs, int16_t* outputs, size_t count)
+{
+  const __m512i zero = _mm512_setzero_si512();
+  const __m512i ones = _mm512_set1_epi16(-1);
+  const __m512i adaptiveLimit = _mm512_set1_epi16(127);
+  const bool emaOn = arrays.emaMode != SlewRateLimiter::SRL_EMA_OFF;
+  const bool drive = arrays.emaMode == SlewRateLimiter::SRL_EMA_DRIVE;
+  size_t c = 0;
+
+  for (; c + 32 <= count; c += 32)
+  {
+    __m512i x = _mm512_loadu_si512((const void*)(inputs + c));
+    __m512i last = _mm512_loadu_si512((const void*)(arrays.lastValue + c));
+    __m512i ema = _mm512_loadu_si512((const void*)(arrays.emaValue + c));
+    __m512i rate = _mm512_loadu_si512((const void*)(arrays.rateLimit + c));
+    __m512i band = _mm512_loadu_si512((const void*)(arrays.hysteresisBand + c));
+    __m512i slope = _mm512_loadu_si512((const void*)(arrays.adaptiveSlopeInternal + c));
+    __mmask32 notFirst = _mm512_cmpeq_epi16_mask(
+        _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i*)(arrays.firstCall + c))), zero);
+
+    __m512i newEma = ema;
+    if (emaOn)
+    {
+      __m256i exponent = _mm256_loadu_si256((const __m256i*)(arrays.smoothingExponent + c));
+      __m512i low = emaUpdateAVX512(_mm512_cvtepi16_epi32(_mm512_castsi512_si256(x)),
+                                    _mm512_cvtepi16_epi32(_mm512_castsi512_si256(ema)),
+                                    _mm512_cvtepu8_epi32(_mm256_castsi256_si128(exponent)));
+      __m512i high = emaUpdateAVX512(_mm512_cvtepi16_epi32(_mm512_extracti64x4_epi64(x, 1)),
+                                     _mm512_cvtepi16_epi32(_mm512_extracti64x4_epi64(ema, 1)),
+                                     _mm512_cvtepu8_epi32(_mm256_extracti128_si256(exponent, 1)));
+      newEma = _mm512_inserti64x4(_mm512_castsi256_si512(_mm512_cvtepi32_epi16(low)), _mm512_cvtepi32_epi16(high), 1);
+    }
+    __m512i target = drive ? newEma : x;
+
+    __m512i absDelta = _mm512_sub_epi16(_mm512_max_epi16(target, last), _mm512_min_epi16(target, last));
+    __m512i productHigh = _mm512_mulhi_epu16(absDelta, slope);
+    __m512i adaptive = _mm512_or_si512(_mm512_slli_epi16(productHigh, 9),
+                                       _mm512_srli_epi16(_mm512_mullo_epi16(absDelta, slope), 7));
+    adaptive = _mm512_mask_blend_epi16(_mm512_cmpgt_epu16_mask(productHigh, adaptiveLimit), adaptive, ones);
+    __m512i allowedChange = _mm512_adds_epu16(rate, adaptive);
+
+    __m512i remaining = _mm512_subs_epu16(absDelta, allowedChange);
+    __mmask32 reached = _mm512_cmple_epu16_mask(remaining, _mm512_max_epi16(band, zero));
+    __m512i limited = _mm512_mask_blend_epi16(_mm512_cmpgt_epi16_mask(target, last),
+                                              _mm512_sub_epi16(last, allowedChange), _mm512_add_epi16(last, allowedChange));
+    limited = _mm512_mask_blend_epi16(reached, limited, target);
+    limited = _mm512_mask_blend_epi16(notFirst, x, limited);
+    newEma = _mm512_mask_blend_epi16(notFirst, x, newEma);
+
+    _mm512_storeu_si512((void*)(arrays.lastValue + c), limited);
+    _mm512_storeu_si512((void*)(arrays.emaValue + c), newEma);
+    _mm512_storeu_si512((void*)(outputs + c), limited);
+    memset(arrays.firstCall + c, 0, 32);
+  }
+
+  return c;
+}
+
+#pragma GCC diagnostic pop
+
+static bool probeAVX512BW()
+{
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx512bw");
+}
+
+#endif /* SRL_HAVE_X86_KERNELS */
+
+void SRL_bank16KernelDispatch(const SRL_Bank16Arrays& arrays, const int16_t* inputs, int16_t* outputs, size_t count)
+{
+  size_t done = 0;
+
+#ifdef SRL_HAVE_X86_KERNELS
+  static const bool haveAVX512BW = probeAVX512BW();
+
+  switch (SRL_activeKernel())
+  {
+    case SRL_KERNEL_AVX512:
+      // The 16-bit AVX-512 kernel needs AVX-512BW on top of AVX-512F; AVX2 is the next widest
+      done = haveAVX512BW ? SRL_bank16KernelAVX512BW(arrays, inputs, outputs, count)
+                          : SRL_bank16KernelAVX2(arrays, inputs, outputs, count);
+      break;
+    case SRL_KERNEL_AVX2:
+      done = SRL_bank16KernelAVX2(arrays, inputs, outputs, count);
+      break;
+    case SRL_KERNEL_SSE41:
+      done = SRL_bank16KernelSSE41(arrays, inputs, outputs, count);
+      break;
+    default:
+      break;
+  }
+#endif
+
+  SRL_bank16KernelScalar(arrays, inputs, outputs, done, count);
+}
@@ -0,0 +1,145 @@
+/**
+ * @file SlewRateLimiterKernels.h
+ * @brief Per-tick update kernels used by SlewRateLimiterBank.
+ *
+ * A kernel updates a range of bank channels with one new input value each. All kernels are bit-exact
+ * with SlewRateLimiter::processValue applied to every channel; they only differ in how many channels
+ * they process per instruction.
+ *
+ * Kernels:
+ * - SRL_bankKernelScalar: Portable C++ kernel, processes the channels in [begin, end).
+ * - SRL_bankUpdateChannel: The scalar update of a single channel, inline, for callers that pick the channels
+ *   themselves (the active set of SlewRateLimiterBank::tick).
+ * - SRL_bankKernelSSE41: 4 channels per instruction (x86 with SSE4.1).
+ * - SRL_bankKernelAVX2: 8 channels per instruction (x86 with AVX2).
+ * - SRL_bankKernelAVX512: 16 channels per instruction (x86 with AVX-512F).
+ * - SRL_bank16Kernel*: The same kernels for the int16_t arrays of SlewRateLimiterBank16, with 8 (SSE4.1),
+ *   16 (AVX2) and 32 (AVX-512BW) channels per instruction. They are bit-exact with
+ *   BasicSlewRateLimiter<int16_t> within the configuration range documented in SlewRateLimiterBank16.h.
+ *
+ * The SIMD kernels process the largest multiple of their width that fits in the channel count and return
+ * the number of channels processed; the caller finishes the remaining channels with the scalar kernel.
+ * They are only declared when SRL_HAVE_X86_KERNELS is defined, and are compiled with per-function target
+ * attributes, so the caller must make sure the CPU supports the instruction set before calling one.
+ *
+ * Dispatch:
+ * - SRL_bankKernelDispatch, SRL_bank16KernelDispatch: Run the active kernel over all channels, including the
+ *   scalar tail. The 16-bit dispatcher falls back to AVX2 when the AVX-512 kernel is active but the CPU
+ *   lacks AVX-512BW.
+ * - SRL_detectKernel: The widest kernel supported by the CPU, probed once on first use.
+ * - SRL_forceKernel: Forces a specific kernel (for testing), or SRL_KERNEL_AUTO to go back to detection.
+ * - SRL_activeKernel, SRL_kernelName: Report which kernel is in use.
+ */
+
+#ifndef SlewRateLimiterKernels_h
+#define SlewRateLimiterKernels_h
+
+#include "SlewRateLimiter.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SRL_HAVE_X86_KERNELS 1
+#endif
+
+enum SRL_Kernel {
+    SRL_KERNEL_AUTO = 0,
+    SRL_KERNEL_SCALAR = 1,
+    SRL_KERNEL_SSE41 = 2,
+    SRL_KERNEL_AVX2 = 3,
+    SRL_KERNEL_AVX512 = 4
+};
+
+/**
+ * Pointers to the structure-of-arrays state and configuration of a bank, plus the bank-wide EMA mode.
+ */
+struct SRL_BankArrays
+{
+    SlewRateLimiter::SRL_EMAMode emaMode;
+    int* lastValue;
+    int* emaValue;
+    const int* rateLimit;
+    const int* hysteresisBand;
+    const int* adaptiveSlopeInternal;
+    const unsigned char* smoothingExponent;
+    unsigned char* firstCall;
+};
+
+/**
+ * Updates channel c exactly like one lane of the kernels and returns whether its state changed. A channel
+ * whose state did not change is at a fixed point: further updates with the same input are no-ops.
+ * emaOn and drive are derived from arrays.emaMode by the caller, once per loop.
+ */
+inline bool SRL_bankUpdateChannel(const SRL_BankArrays& arrays, const int* inputs, int* outputs, size_t c,
+                                  bool emaOn, bool drive)
+{
+  int currentValue = inputs[c];
+  int last = arrays.lastValue[c];
+  int ema = arrays.emaValue[c];
+  int exponent = arrays.smoothingExponent[c];
+
+  // Same EMA update as SlewRateLimiter::updateEMA; in drive mode the EMA is limited instead of the input
+  int scale = 1 << exponent;
+  int newEma = emaOn ? (currentValue * scale + ema * 1024 - ema * scale) >> 10 : ema;
+  int target = drive ? newEma : currentValue;
+
+  // A zero adaptive slope adds nothing, so no branch is needed to skip it
+  int delta = target - last;
+  int allowedChange = arrays.rateLimit[c] + ((abs(delta) * arrays.adaptiveSlopeInternal[c])>>7);
+
+  // Rate limiting
+  int limited = (delta > allowedChange) ? last + allowedChange
+              : (delta < -allowedChange) ? last - allowedChange
+              : target;
+
+  // Apply hysteresis
+  limited = (abs(target - limited) <= arrays.hysteresisBand[c]) ? target : limited;
+
+  // The first value of a channel is passed straight through
+  bool first = arrays.firstCall[c] != 0;
+  int newLast = first ? currentValue : limited;
+  newEma = first ? currentValue : newEma;
+  arrays.lastValue[c] = newLast;
+  arrays.emaValue[c] = newEma;
+  arrays.firstCall[c] = 0;
+  outputs[c] = newLast;
+  return first || newLast != last || newEma != ema;
+}
+
+void SRL_bankKernelScalar(const SRL_BankArrays& arrays, const int* inputs, int* outputs, size_t begin, size_t end);
+
+#ifdef SRL_HAVE_X86_KERNELS
+size_t SRL_bankKernelSSE41(const SRL_BankArrays& arrays, const int* inputs, int* outputs, size_t count);
+size_t SRL_bankKernelAVX2(const SRL_BankArrays& arrays, const int* inputs, int* outputs, size_t count);
+size_t SRL_bankKernelAVX512(const SRL_BankArrays& arrays, const int* inputs, int* outputs, size_t count);
+#endif
+
+/**
+ * The same arrays for SlewRateLimiterBank16.
+ */
+struct SRL_Bank16Arrays
+{
+    SlewRateLimiter::SRL_EMAMode emaMode;
+    int16_t* lastValue;
+    int16_t* emaValue;
+    const int16_t* rateLimit;
+    const int16_t* hysteresisBand;
+    const int16_t* adaptiveSlopeInternal;
+    const unsigned char* smoothingExponent;
+    unsigned char* firstCall;
+};
+
+void SRL_bank16KernelScalar(const SRL_Bank16Arrays& arrays, const int16_t* inputs, int16_t* outputs, size_t begin, size_t end);
+
+#ifdef SRL_HAVE_X86_KERNELS
+size_t SRL_bank16KernelSSE41(const SRL_Bank16Arrays& arrays, const int16_t* inputs, int16_t* outputs, size_t count);
+size_t SRL_bank16KernelAVX2(const SRL_Bank16Arrays& arrays, const int16_t* inputs, int16_t* outputs, size_t count);
+size_t SRL_bank16KernelAVX512BW(const SRL_Bank16Arrays& arrays, const int16_t* inputs, int16_t* outputs, size_t count);
+#endif
+
+void SRL_bankKernelDispatch(const SRL_BankArrays& arrays, const int* inputs, int* outputs, size_t count);
+void SRL_bank16KernelDispatch(const SRL_Bank16Arrays& arrays, const int16_t* inputs, int16_t* outputs, size_t count);
+SRL_Kernel SRL_detectKernel();
+bool SRL_forceKernel(SRL_Kernel kernel);
+SRL_Kernel SRL_activeKernel();
+const char* SRL_kernelName(SRL_Kernel kernel);
+
+#endif /* SlewRateLimiterKernels_h */
@@ -0,0 +1,165 @@
+/**
+ * @file SlewRateLimiterMappedBank.cpp
+ * @brief Implements the SlewRateLimiterMappedBank class, a bank whose state is a memory-mapped file.
+ *
+ * The file is sized once, mapped shared, and its state arrays are handed to SlewRateLimiterBank, which
+ * resumes from them in place. Nothing is read or converted on open beyond the 64-byte header.
+ *
+ * Methods:
+ * - SlewRateLimiterMappedBank: Opens, validates or initializes, and maps the file, then marks it dirty.
+ * - status, bank: The outcome of opening, and the bank.
+ * - sync: msync of the whole mapping.
+ * - close: Flushes the arrays, then marks the file clean and flushes the header, so a clean flag on disk
+ *   always comes with the state it vouches for.
+ * - SRL_alignMapped: Rounds an array offset up to 64 bytes.
+ */
+
+
+#include "SlewRateLimiterMappedBank.h"
+
+#ifdef SRL_HAVE_MAPPED_BANK
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static size_t SRL_alignMapped(size_t offset)
+{
+  return (offset + 63) & ~(size_t)63;
+}
+
+SlewRateLimiterMappedBank::SlewRateLimiterMappedBank(
+    const char* path,
+    size_t channels,
+    SlewRateLimiter::SRL_SmoothingExponent exponent, 
+    int rate, 
+    int hystBand, 
+    int slope,
+    SlewRateLimiter::SRL_EMAMode mode
+)
+  : mapping(NULL),
+    mappingSize(0),
+    header(NULL),
+    limiterBank(NULL),
+    openStatus(SRL_MAPPED_ERROR_IO)
+{
+  const size_t lastOffset = SRL_alignMapped(sizeof(SRL_MappedBankHeader));
+  const size_t emaOffset = SRL_alignMapped(lastOffset + channels * sizeof(int));
+  const size_t firstOffset = SRL_alignMapped(emaOffset + channels * sizeof(int));
+  const size_t size = firstOffset + channels;
+
+  int fd = open(path, O_RDWR | O_CREAT, 0644);
+  if (fd < 0)
+  {
+    return;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || (info.st_size == 0 && ftruncate(fd, (off_t)size) != 0))
+  {
+    ::close(fd);
+    return;
+  }
+  if (info.st_size != 0 && (size_t)info.st_size != size)
+  {
+    // Another channel count or layout: refuse rather than lose the state in it
+    ::close(fd);
+    openStatus = SRL_MAPPED_ERROR_LAYOUT;
+    return;
+  }
+
+  // The mapping keeps the file open
+  void* p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED)
+  {
+    return;
+  }
+  mapping = p;
+  mappingSize = size;
+  header = (SRL_MappedBankHeader*)p;
+  unsigned char* base = (unsigned char*)p;
+  int* lastValues = (int*)(base + lastOffset);
+  int* emaValues = (int*)(base + emaOffset);
+  unsigned char* firstCalls = base + firstOffset;
+
+  static const char noMagic[sizeof(header->magic)] = { 0 };
+  if (memcmp(header->magic, noMagic, sizeof(header->magic)) == 0)
+  {
+    // New file (or one whose creation was interrupted): ftruncate zero-filled it. The magic is written last,
+    // so a file only counts as initialized once everything else is.
+    memset(firstCalls, 1, channels);
+    header->version = SRL_MAPPED_BANK_VERSION;
+    header->byteOrder = SRL_MAPPED_BANK_BYTE_ORDER;
+    header->intSize = sizeof(int);
+    header->headerSize = sizeof(SRL_MappedBankHeader);
+    header->channels = channels;
+    memcpy(header->magic, SRL_MAPPED_BANK_MAGIC, sizeof(header->magic));
+    openStatus = SRL_MAPPED_CREATED;
+  }
+  else if (memcmp(header->magic, SRL_MAPPED_BANK_MAGIC, sizeof(header->magic)) != 0
+           || header->version != SRL_MAPPED_BANK_VERSION
+           || header->byteOrder != SRL_MAPPED_BANK_BYTE_ORDER
+           || header->intSize != sizeof(int)
+           || header->headerSize != sizeof(SRL_MappedBankHeader)
+           || header->channels != channels)
+  {
+    munmap(mapping, mappingSize);
+    mapping = NULL;
+    mappingSize = 0;
+    header = NULL;
+    openStatus = SRL_MAPPED_ERROR_LAYOUT;
+    return;
+  }
+  else
+  {
+    openStatus = (header->consistency == SRL_MAPPED_BANK_CLEAN) ? SRL_MAPPED_RESUMED : SRL_MAPPED_RECOVERED;
+  }
+
+  header->consistency = SRL_MAPPED_BANK_DIRTY;
+  limiterBank = new SlewRateLimiterBank(channels, lastValues, emaValues, firstCalls, exponent, rate, hystBand,
+                                        slope, mode);
+}
+
+SlewRateLimiterMappedBank::~SlewRateLimiterMappedBank()
+{
+  close();
+}
+
+SRL_MappedStatus SlewRateLimiterMappedBank::status() const
+{
+  return openStatus;
+}
+
+SlewRateLimiterBank* SlewRateLimiterMappedBank::bank()
+{
+  return limiterBank;
+}
+
+bool SlewRateLimiterMappedBank::sync()
+{
+  return mapping != NULL && msync(mapping, mappingSize, MS_SYNC) == 0;
+}
+
+void SlewRateLimiterMappedBank::close()
+{
+  if (mapping == NULL)
+  {
+    return;
+  }
+  delete limiterBank;
+  limiterBank = NULL;
+
+  // The state must be on disk before the flag that says it is complete
+  msync(mapping, mappingSize, MS_SYNC);
+  header->consistency = SRL_MAPPED_BANK_CLEAN;
+  msync(mapping, sizeof(SRL_MappedBankHeader), MS_SYNC);
+
+  munmap(mapping, mappingSize);
+  mapping = NULL;
+  mappingSize = 0;
+  header = NULL;
+}
+
+#endif /* SRL_HAVE_MAPPED_BANK */
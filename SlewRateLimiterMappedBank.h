@@ -0,0 +1,114 @@
+/**
+ * @file SlewRateLimiterMappedBank.h
+ * @brief A SlewRateLimiterBank whose state lives in a memory-mapped file (POSIX hosts only).
+ *
+ * The per-channel state arrays of the bank (last output, EMA, first-call flag) are mapped from a file with
+ * mmap(MAP_SHARED), and the bank processes them in place. Every store goes straight to the page cache, so a
+ * process that crashes or is restarted resumes every channel from the file with no deserialization step:
+ * opening the file maps it, checks the header and hands the arrays to the bank. The configuration is not
+ * persisted; the application sets it again after opening, as it would for a new bank.
+ *
+ * File layout (native byte order; the header records enough to refuse a file from another layout):
+ * - SRL_MappedBankHeader, 64 bytes: magic, version, byte-order mark, sizeof(int), channel count, and the
+ *   consistency flag.
+ * - lastValue: int[channels], at a 64-byte aligned offset.
+ * - emaValue: int[channels], at a 64-byte aligned offset.
+ * - firstCall: unsigned char[channels], at a 64-byte aligned offset.
+ *
+ * The consistency flag is set to dirty when the file is opened and back to clean by close() (or the
+ * destructor), after the arrays have been flushed to disk. Opening a dirty file reports
+ * SRL_MAPPED_RECOVERED: the previous process did not close it, so a tick may have been interrupted and
+ * the channels it reached are one tick ahead of the others.
+ *
+ * Major methods:
+ * - SlewRateLimiterMappedBank: Opens or creates the file; status() tells which, or why it failed.
+ * - bank: The bank over the mapped state, or NULL if the file could not be opened.
+ * - sync: Flushes the state to disk (msync). Only needed to survive an OS crash or power loss; a process
+ *   crash leaves the page cache intact.
+ * - close: Flushes the state, marks the file clean and unmaps it.
+ *
+ * Major variables:
+ * - mapping, mappingSize: The mapped file.
+ * - header: The header at the start of the mapping.
+ * - limiterBank: The bank over the arrays in the mapping.
+ * - openStatus: The outcome of opening the file.
+ *
+ * @note Only defined where SRL_HAVE_MAPPED_BANK is (POSIX hosts with mmap, not Arduino).
+ */
+
+#ifndef SlewRateLimiterMappedBank_h
+#define SlewRateLimiterMappedBank_h
+
+#include "SlewRateLimiterBank.h"
+
+#if !defined(ARDUINO) && (defined(__unix__) || defined(__APPLE__))
+#define SRL_HAVE_MAPPED_BANK 1
+#endif
+
+#ifdef SRL_HAVE_MAPPED_BANK
+
+#define SRL_MAPPED_BANK_MAGIC "SRLBANK"
+#define SRL_MAPPED_BANK_VERSION 1
+#define SRL_MAPPED_BANK_BYTE_ORDER 0x01020304UL
+#define SRL_MAPPED_BANK_CLEAN 0x434C454EUL
+#define SRL_MAPPED_BANK_DIRTY 0x44495254UL
+
+/**
+ * The 64-byte header at the start of a mapped bank file.
+ */
+struct SRL_MappedBankHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t intSize;
+    uint32_t headerSize;
+    uint64_t channels;
+    uint32_t consistency;
+    uint32_t reserved[7];
+};
+
+static_assert(sizeof(SRL_MappedBankHeader) == 64, "SRL_MappedBankHeader must stay 64 bytes");
+
+enum SRL_MappedStatus {
+    SRL_MAPPED_CREATED = 0,       // New (or empty) file: every channel starts from the first-call state
+    SRL_MAPPED_RESUMED = 1,       // The file was closed cleanly: every channel resumes where it was
+    SRL_MAPPED_RECOVERED = 2,     // The file was not closed (crash): channels resume, the last tick may be partial
+    SRL_MAPPED_ERROR_IO = 3,      // The file could not be opened, sized or mapped
+    SRL_MAPPED_ERROR_LAYOUT = 4   // The file belongs to another layout, version or channel count
+};
+
+class SlewRateLimiterMappedBank 
+{
+public:
+    SlewRateLimiterMappedBank(
+        const char* path,
+        size_t channels,
+        SlewRateLimiter::SRL_SmoothingExponent exponent = SlewRateLimiter::SRL_SMOOTHING_4, 
+        int rate = 5, 
+        int hystBand = 2,
+        int slope = 0,
+        SlewRateLimiter::SRL_EMAMode mode = SlewRateLimiter::SRL_EMA_TRACK
+    );
+    ~SlewRateLimiterMappedBank();
+
+    SRL_MappedStatus status() const;
+    SlewRateLimiterBank* bank();
+    bool sync();
+    void close();
+
+private:
+    // Not copyable: the object owns the mapping
+    SlewRateLimiterMappedBank(const SlewRateLimiterMappedBank&);
+    SlewRateLimiterMappedBank& operator=(const SlewRateLimiterMappedBank&);
+
+    void* mapping;
+    size_t mappingSize;
+    SRL_MappedBankHeader* header;
+    SlewRateLimiterBank* limiterBank;
+    SRL_MappedStatus openStatus;
+};
+
+#endif /* SRL_HAVE_MAPPED_BANK */
+
+#endif /* SlewRateLimiterMappedBank_h */
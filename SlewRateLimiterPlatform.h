@@ -0,0 +1,92 @@
+/**
+ * @file SlewRateLimiterPlatform.h
+ * @brief Portability layer between Arduino builds and host (non-Arduino) builds.
+ *
+ * On Arduino this simply includes "Arduino.h". Elsewhere (for example a Linux host that replays recorded
+ * telemetry through the limiter) it includes the few standard headers the library relies on instead:
+ * size_t, the fixed-width integer types, INT_MAX and abs().
+ *
+ * SRL_micros() is the microsecond clock for SlewRateLimiter::processValueAt: micros() on Arduino, and
+ * CLOCK_MONOTONIC on POSIX hosts. Like micros() it wraps around; processValueAt only uses differences of
+ * 32-bit timestamps, so the wrap is harmless.
+ *
+ * SRL_scaleRate is the time scaling of processValueAt: elapsed microseconds times a 32.32 fixed-point rate per
+ * microsecond, plus the carried fraction. SRL_scaleRate64 is one 32x32->64 multiply per part, which is cheap
+ * on 32- and 64-bit targets but a libgcc 64-bit multiply call on AVR. SRL_scaleRate32 is the AVR version: for
+ * the usual call spacing (elapsed and the whole rate both below 2^16, i.e. calls less than 65 ms apart) it uses
+ * three 16x16->32 multiplies and 32-bit adds with explicit carries, and only a longer gap falls back to the
+ * 64-bit path. Both return exactly the same result and carry.
+ */
+
+#ifndef SlewRateLimiterPlatform_h
+#define SlewRateLimiterPlatform_h
+
+#include <limits.h>
+
+#if defined(ARDUINO)
+#include "Arduino.h"
+
+static inline unsigned long SRL_micros()
+{
+  return micros();
+}
+#else
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <time.h>
+
+static inline unsigned long SRL_micros()
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (unsigned long)now.tv_sec * 1000000UL + (unsigned long)(now.tv_nsec / 1000);
+}
+#endif
+#endif
+
+/**
+ * Returns elapsed * (whole + fraction / 2^32) + carry / 2^32 in whole units (saturated at 0xFFFFFFFF) and
+ * leaves the new fraction in carry.
+ */
+static inline uint32_t SRL_scaleRate64(uint32_t elapsed, uint32_t whole, uint32_t fraction, uint32_t& carry)
+{
+  uint64_t fractionSum = (uint64_t)elapsed * fraction + carry;
+  carry = (uint32_t)fractionSum;
+  uint64_t units = (uint64_t)elapsed * whole + (fractionSum >> 32);
+  return (units > 0xFFFFFFFFUL) ? 0xFFFFFFFFUL : (uint32_t)units;
+}
+
+static inline uint32_t SRL_scaleRate32(uint32_t elapsed, uint32_t whole, uint32_t fraction, uint32_t& carry)
+{
+  if (elapsed > 0xFFFFUL || whole > 0xFFFFUL)
+  {
+    return SRL_scaleRate64(elapsed, whole, fraction, carry);
+  }
+
+  // elapsed * fraction = high * 2^16 + low, from two 16x16->32 multiplies; the bits above 2^32 are whole units
+  uint16_t e = (uint16_t)elapsed;
+  uint32_t low = (uint32_t)e * (uint16_t)fraction;
+  uint32_t high = (uint32_t)e * (uint16_t)(fraction >> 16);
+  uint32_t product = low + (high << 16);
+  uint32_t units = (high >> 16) + (product < low ? 1 : 0);
+  uint32_t sum = product + carry;
+  units += (sum < product) ? 1 : 0;
+  carry = sum;
+
+  // At most (2^16 - 1)^2 + 2^16 + 1, which fits in 32 bits
+  return (uint32_t)e * (uint16_t)whole + units;
+}
+
+static inline uint32_t SRL_scaleRate(uint32_t elapsed, uint32_t whole, uint32_t fraction, uint32_t& carry)
+{
+#if defined(__AVR__)
+  return SRL_scaleRate32(elapsed, whole, fraction, carry);
+#else
+  return SRL_scaleRate64(elapsed, whole, fraction, carry);
+#endif
+}
+
+#endif /* SlewRateLimiterPlatform_h */
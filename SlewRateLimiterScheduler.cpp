@@ -0,0 +1,268 @@
+/**
+ * @file SlewRateLimiterScheduler.cpp
+ * @brief Implements the SlewRateLimiterScheduler class, a timing-wheel scheduler of slew rate limiters.
+ *
+ * Every channel is a SlewRateLimiter whose state is as of tick lastUpdate. Catching it up to the current
+ * tick with advance(target, now - lastUpdate) gives exactly the state of processing target on every tick
+ * in between, because the target has not changed since lastUpdate: every change goes through setTarget,
+ * which materializes the channel first.
+ *
+ * Methods:
+ * - setTarget: Materializes a channel, stores its new target and reschedules it.
+ * - tick: Increments the tick counter, cascades the wheel levels that wrapped, and settles the due channels.
+ * - settledChannel: The channels settled by the last tick.
+ * - getValue, getEMA: Materialize a channel and return its output or EMA.
+ * - isScheduled: Whether a channel is in the wheel.
+ * - setRateLimit, setHysteresisBand, setSmoothingExponent, setAdaptiveSlope: Materialize, reconfigure and
+ *   reschedule a channel.
+ * - materialize, schedule, insert, unlink, cascade: The lazy evaluation and the wheel operations.
+ */
+
+
+#include "SlewRateLimiterScheduler.h"
+
+// Empty list, and slotOf value of a channel that is not in the wheel
+static const uint32_t SRL_WHEEL_NIL = 0xFFFFFFFFUL;
+
+SlewRateLimiterScheduler::SlewRateLimiterScheduler(
+    size_t channels,
+    SlewRateLimiter::SRL_SmoothingExponent exponent, 
+    int rate, 
+    int hystBand, 
+    int slope,
+    SlewRateLimiter::SRL_EMAMode mode
+)
+  : channelCount((uint32_t)channels),
+    currentTick(0),
+    limiters(new SlewRateLimiter[channels]),
+    targets(new int[channels]),
+    lastUpdate(new uint32_t[channels]),
+    expiry(new uint32_t[channels]),
+    next(new uint32_t[channels]),
+    prev(new uint32_t[channels]),
+    slotOf(new uint32_t[channels]),
+    settled(new uint32_t[channels]),
+    settledCount(0)
+{
+  for (uint32_t s = 0; s < LEVELS * SLOTS; s++)
+  {
+    heads[s] = SRL_WHEEL_NIL;
+  }
+  for (uint32_t c = 0; c < channelCount; c++)
+  {
+    limiters[c].setSmoothingExponent(exponent);
+    limiters[c].setRateLimit(rate);
+    limiters[c].setHysteresisBand(hystBand);
+    limiters[c].setAdaptiveSlope(slope);
+    limiters[c].setEMAMode(mode);
+    targets[c] = 0;
+    lastUpdate[c] = 0;
+    expiry[c] = 0;
+    next[c] = SRL_WHEEL_NIL;
+    prev[c] = SRL_WHEEL_NIL;
+    slotOf[c] = SRL_WHEEL_NIL;
+  }
+}
+
+SlewRateLimiterScheduler::~SlewRateLimiterScheduler()
+{
+  delete[] limiters;
+  delete[] targets;
+  delete[] lastUpdate;
+  delete[] expiry;
+  delete[] next;
+  delete[] prev;
+  delete[] slotOf;
+  delete[] settled;
+}
+
+size_t SlewRateLimiterScheduler::size() const
+{
+  return channelCount;
+}
+
+uint32_t SlewRateLimiterScheduler::now() const
+{
+  return currentTick;
+}
+
+void SlewRateLimiterScheduler::setTarget(size_t channel, int value)
+{
+  uint32_t c = (uint32_t)channel;
+  materialize(c);
+  targets[c] = value;
+  schedule(c);
+}
+
+size_t SlewRateLimiterScheduler::tick()
+{
+  currentTick++;
+  settledCount = 0;
+
+  // When a level wraps, the current slot of the level above comes into range. Cascade from the top down,
+  // so channels that a higher level drops into the current slot of a lower one are cascaded on this tick.
+  if ((currentTick & (SLOTS - 1)) == 0)
+  {
+    if (((currentTick >> SLOT_BITS) & (SLOTS - 1)) == 0)
+    {
+      if (((currentTick >> (2 * SLOT_BITS)) & (SLOTS - 1)) == 0)
+      {
+        cascade(3);
+      }
+      cascade(2);
+    }
+    cascade(1);
+  }
+
+  // Every channel left in the current level-0 slot settles on this tick
+  uint32_t c = heads[currentTick & (SLOTS - 1)];
+  while (c != SRL_WHEEL_NIL)
+  {
+    uint32_t following = next[c];
+    unlink(c);
+    materialize(c);
+    settled[settledCount++] = c;
+
+    // A channel further away than the 32-bit tick counter reaches was scheduled at the horizon instead
+    if (!limiters[c].isSettled())
+    {
+      schedule(c);
+    }
+    c = following;
+  }
+  return settledCount;
+}
+
+size_t SlewRateLimiterScheduler::settledChannel(size_t index) const
+{
+  return settled[index];
+}
+
+int SlewRateLimiterScheduler::getValue(size_t channel)
+{
+  materialize((uint32_t)channel);
+  return limiters[channel].getValue();
+}
+
+int SlewRateLimiterScheduler::getEMA(size_t channel)
+{
+  materialize((uint32_t)channel);
+  return limiters[channel].getEMA();
+}
+
+bool SlewRateLimiterScheduler::isScheduled(size_t channel) const
+{
+  return slotOf[channel] != SRL_WHEEL_NIL;
+}
+
+void SlewRateLimiterScheduler::setRateLimit(size_t channel, int limit)
+{
+    materialize((uint32_t)channel);
+    limiters[channel].setRateLimit(limit);
+    schedule((uint32_t)channel);
+}
+
+void SlewRateLimiterScheduler::setHysteresisBand(size_t channel, int band)
+{
+    materialize((uint32_t)channel);
+    limiters[channel].setHysteresisBand(band);
+    schedule((uint32_t)channel);
+}
+
+void SlewRateLimiterScheduler::setSmoothingExponent(size_t channel, SlewRateLimiter::SRL_SmoothingExponent exponent)
+{
+    materialize((uint32_t)channel);
+    limiters[channel].setSmoothingExponent(exponent);
+    schedule((uint32_t)channel);
+}
+
+void SlewRateLimiterScheduler::setAdaptiveSlope(size_t channel, int slope)
+{
+    materialize((uint32_t)channel);
+    limiters[channel].setAdaptiveSlope(slope);
+    schedule((uint32_t)channel);
+}
+
+void SlewRateLimiterScheduler::materialize(uint32_t channel)
+{
+  uint32_t elapsed = currentTick - lastUpdate[channel];
+  if (elapsed != 0)
+  {
+    limiters[channel].advance(targets[channel], elapsed);
+    lastUpdate[channel] = currentTick;
+  }
+}
+
+void SlewRateLimiterScheduler::schedule(uint32_t channel)
+{
+  unlink(channel);
+  unsigned long ticks = limiters[channel].ticksToSettle(targets[channel]);
+  if (ticks == 0 || ticks == SRL_NEVER_SETTLES)
+  {
+    return;
+  }
+
+  // Ramps longer than the wheel are parked at its horizon and rescheduled when they get there
+  expiry[channel] = currentTick + (uint32_t)(ticks < 0xFFFFFFFFUL ? ticks : 0xFFFFFFFFUL);
+  insert(channel);
+}
+
+void SlewRateLimiterScheduler::insert(uint32_t channel)
+{
+  // The level is the first one whose range covers the distance to the expiry; the slot is the expiry's
+  // digit at that level, so the channel is cascaded when the lower digits of the tick counter wrap to it
+  uint32_t when = expiry[channel];
+  uint32_t distance = when - currentTick;
+  int level = 0;
+  while (level < LEVELS - 1 && distance >= (1UL << ((level + 1) * SLOT_BITS)))
+  {
+    level++;
+  }
+  uint32_t slot = (uint32_t)level * SLOTS + ((when >> (level * SLOT_BITS)) & (SLOTS - 1));
+
+  next[channel] = heads[slot];
+  prev[channel] = SRL_WHEEL_NIL;
+  if (heads[slot] != SRL_WHEEL_NIL)
+  {
+    prev[heads[slot]] = channel;
+  }
+  heads[slot] = channel;
+  slotOf[channel] = slot;
+}
+
+void SlewRateLimiterScheduler::unlink(uint32_t channel)
+{
+  uint32_t slot = slotOf[channel];
+  if (slot == SRL_WHEEL_NIL)
+  {
+    return;
+  }
+  if (prev[channel] != SRL_WHEEL_NIL)
+  {
+    next[prev[channel]] = next[channel];
+  }
+  else
+  {
+    heads[slot] = next[channel];
+  }
+  if (next[channel] != SRL_WHEEL_NIL)
+  {
+    prev[next[channel]] = prev[channel];
+  }
+  slotOf[channel] = SRL_WHEEL_NIL;
+}
+
+void SlewRateLimiterScheduler::cascade(int level)
+{
+  // Detach the whole slot first: insert may put a channel back into a slot of this level
+  uint32_t slot = (uint32_t)level * SLOTS + ((currentTick >> (level * SLOT_BITS)) & (SLOTS - 1));
+  uint32_t c = heads[slot];
+  heads[slot] = SRL_WHEEL_NIL;
+  while (c != SRL_WHEEL_NIL)
+  {
+    uint32_t following = next[c];
+    slotOf[c] = SRL_WHEEL_NIL;
+    insert(c);
+    c = following;
+  }
+}
@@ -0,0 +1,100 @@
+/**
+ * @file SlewRateLimiterScheduler.h
+ * @brief Event-driven slew rate limiting for large banks of sparse, slow ramps.
+ *
+ * SlewRateLimiterScheduler runs many independent SlewRateLimiter channels that conceptually process their
+ * current target once per tick, but it does no per-channel work on ticks where nothing happens:
+ * - A channel's state is only materialized (caught up with SlewRateLimiter::advance) when its target or its
+ *   configuration changes, when it is read, and when it settles.
+ * - A ramping channel is placed in a hierarchical timing wheel at the tick at which it reaches its target
+ *   (SlewRateLimiter::ticksToSettle). tick() only visits the channels whose settle tick has come, so the
+ *   cost of a tick is proportional to the number of events instead of the number of channels.
+ *
+ * The values read are exactly those of calling processValue(target) on every channel on every tick.
+ *
+ * The wheel has 4 levels of 256 slots, covering the full 32-bit tick counter: level 0 holds the channels
+ * that settle within 256 ticks, level 1 within 65536, and so on. When the lower levels wrap, the next slot
+ * of the level above is cascaded down. Each slot is an intrusive doubly linked list threaded through
+ * per-channel index arrays, so scheduling and unscheduling a channel is O(1) and nothing is allocated
+ * after construction.
+ *
+ * Major methods:
+ * - setTarget: Sets the input of a channel from the next tick on, and reschedules it.
+ * - tick: Advances the tick counter and settles the channels due at the new tick; returns their number.
+ * - settledChannel: The channels settled by the last tick.
+ * - getValue, getEMA: Materialize a channel and return its output or EMA.
+ * - isScheduled: Whether a channel is still ramping towards its target.
+ * - setRateLimit, setHysteresisBand, setSmoothingExponent, setAdaptiveSlope: Per-channel configuration.
+ * - now: The current tick.
+ *
+ * Major variables:
+ * - limiters, targets: Per-channel limiter (state as of tick lastUpdate) and current input.
+ * - lastUpdate, expiry: Per-channel tick of the last materialization and of the scheduled settle event.
+ * - next, prev, slotOf: Per-channel links of the wheel lists, and the slot the channel is in.
+ * - heads: The first channel of each of the 4 x 256 slot lists.
+ *
+ * @note ticksToSettle is closed-form for a fixed rate outside drive mode. With the adaptive slope, or in
+ *       drive mode, scheduling a channel simulates its ramp once.
+ */
+
+#ifndef SlewRateLimiterScheduler_h
+#define SlewRateLimiterScheduler_h
+
+#include "SlewRateLimiter.h"
+
+class SlewRateLimiterScheduler 
+{
+public:
+    SlewRateLimiterScheduler(
+        size_t channels,
+        SlewRateLimiter::SRL_SmoothingExponent exponent = SlewRateLimiter::SRL_SMOOTHING_4, 
+        int rate = 5, 
+        int hystBand = 2,
+        int slope = 0,
+        SlewRateLimiter::SRL_EMAMode mode = SlewRateLimiter::SRL_EMA_TRACK
+    );
+    ~SlewRateLimiterScheduler();
+
+    size_t size() const;
+    uint32_t now() const;
+    void setTarget(size_t channel, int value);
+    size_t tick();
+    size_t settledChannel(size_t index) const;
+    int getValue(size_t channel);
+    int getEMA(size_t channel);
+    bool isScheduled(size_t channel) const;
+    void setRateLimit(size_t channel, int limit);
+    void setHysteresisBand(size_t channel, int band);
+    void setSmoothingExponent(size_t channel, SlewRateLimiter::SRL_SmoothingExponent exponent);
+    void setAdaptiveSlope(size_t channel, int slope);
+
+private:
+    // Not copyable: the scheduler owns its arrays
+    SlewRateLimiterScheduler(const SlewRateLimiterScheduler&);
+    SlewRateLimiterScheduler& operator=(const SlewRateLimiterScheduler&);
+
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 8;
+    static const uint32_t SLOTS = 1UL << SLOT_BITS;
+
+    void materialize(uint32_t channel);
+    void schedule(uint32_t channel);
+    void insert(uint32_t channel);
+    void unlink(uint32_t channel);
+    void cascade(int level);
+
+    uint32_t channelCount;
+    uint32_t currentTick;
+    SlewRateLimiter* limiters;
+    int* targets;
+    uint32_t* lastUpdate;
+    uint32_t* expiry;
+    uint32_t* next;
+    uint32_t* prev;
+    uint32_t* slotOf;
+    uint32_t* settled;
+    uint32_t settledCount;
+    uint32_t heads[LEVELS * SLOTS];
+};
+
+#endif /* SlewRateLimiterScheduler_h */
@@ -0,0 +1,45 @@
+/**
+ * @file SlewRateLimiterState.h
+ * @brief SRL_State, the packed 8-byte per-channel state of a slew rate limiter.
+ *
+ * SRL_State holds only what changes from sample to sample: the last output value and the EMA, as two int32_t.
+ * The first-call flag takes no space of its own. A channel that has not processed a value yet is marked by
+ * the pair (SRL_STATE_FIRST_LAST, SRL_STATE_FIRST_EMA), which a running limiter never reaches inside the
+ * defined 16-bit data domain: the EMA stays within the range of the inputs.
+ *
+ * SRL_State is a trivially copyable POD with no constructor, so arrays of it can be memset, memcpy'd or
+ * written to disk as they are.
+ *
+ * Functions:
+ * - SRL_initialState: The state of a channel that has not processed a value yet.
+ * - SRL_isFirstCall: Whether a state is that initial state.
+ */
+
+#ifndef SlewRateLimiterState_h
+#define SlewRateLimiterState_h
+
+#include "SlewRateLimiterPlatform.h"
+
+#define SRL_STATE_FIRST_LAST INT32_MIN
+#define SRL_STATE_FIRST_EMA INT32_MAX
+
+struct SRL_State
+{
+    int32_t lastValue;
+    int32_t emaValue;
+};
+
+static_assert(sizeof(SRL_State) == 8, "SRL_State must stay packed into 8 bytes");
+
+inline SRL_State SRL_initialState()
+{
+  SRL_State state = { SRL_STATE_FIRST_LAST, SRL_STATE_FIRST_EMA };
+  return state;
+}
+
+inline bool SRL_isFirstCall(const SRL_State& state)
+{
+  return state.lastValue == SRL_STATE_FIRST_LAST && state.emaValue == SRL_STATE_FIRST_EMA;
+}
+
+#endif /* SlewRateLimiterState_h */
@@ -0,0 +1,183 @@
+/**
+ * @file SlewRateLimiterStatic.h
+ * @brief Compile-time specialized variants of SlewRateLimiter with unused stages compiled out.
+ *
+ * SlewRateLimiter decides at run time whether the adaptive slope, the hysteresis and the EMA are in use,
+ * and pays for those checks on every call. The templates in this file make the same decisions at compile
+ * time, so a disabled stage generates no instructions at all:
+ *
+ * - StaticSlewRateLimiter<Exponent, Adaptive, Hysteresis, Mode>: The smoothing exponent, the enabled stages and
+ *   the EMA mode are template parameters; the rate limit, hysteresis band and slope stay runtime values.
+ * - ConstSlewRateLimiter<Exponent, Rate, HystBand, Slope, Mode>: Every parameter is a compile-time
+ *   constant. The adaptive stage is enabled when Slope is non-zero and the hysteresis when HystBand is
+ *   positive (a band of zero or less never changes the output).
+ *
+ * Mode is the SRL_EMAMode of SlewRateLimiter: SRL_EMA_OFF (the default) generates no EMA code, SRL_EMA_TRACK
+ * maintains the EMA for getEMA, and SRL_EMA_DRIVE limits the EMA instead of the raw input.
+ *
+ * Both templates and SlewRateLimiter run the same limiter step, SRL_limitStep<Adaptive, Hysteresis>
+ * (SlewRateLimiterStep.h): SlewRateLimiter is the instantiation with both stages enabled and runtime values.
+ * With every stage enabled the output and EMA are bit-exact with SlewRateLimiter::processValue in the same
+ * mode. Disabling a stage gives the same output as SlewRateLimiter with a slope of 0 (Adaptive) or a band of
+ * 0 (Hysteresis).
+ *
+ * Header-only: there is nothing to compile in the library for these templates.
+ */
+
+#ifndef SlewRateLimiterStatic_h
+#define SlewRateLimiterStatic_h
+
+#include "SlewRateLimiter.h"
+
+template <
+    SlewRateLimiter::SRL_SmoothingExponent Exponent = SlewRateLimiter::SRL_SMOOTHING_4,
+    bool Adaptive = false,
+    bool Hysteresis = true,
+    SlewRateLimiter::SRL_EMAMode Mode = SlewRateLimiter::SRL_EMA_OFF
+>
+class StaticSlewRateLimiter 
+{
+public:
+    /**
+     * The slope is only used when Adaptive is true, and the band only when Hysteresis is true; otherwise they
+     * are ignored, as the stage is compiled out.
+     */
+    StaticSlewRateLimiter(int rate = 5, int hystBand = 2, int slope = 0)
+      : lastValue(0),
+        emaValue(0),
+        isFirstCall(true),
+        rateLimit(rate),
+        hysteresisBand(hystBand),
+        adaptiveSlopeInternal(0)
+    {
+      setAdaptiveSlope(slope);
+    }
+
+    int processValue(int currentValue)
+    {
+      if (isFirstCall)
+      {
+        lastValue = currentValue;
+        emaValue = currentValue;
+        isFirstCall = false;
+        return currentValue;
+      }
+
+      int target = currentValue;
+      if (Mode != SlewRateLimiter::SRL_EMA_OFF)
+      {
+        emaValue = updateEMA(currentValue, emaValue);
+
+        // In drive mode the smoothed signal is limited instead of the raw input
+        if (Mode == SlewRateLimiter::SRL_EMA_DRIVE)
+        {
+          target = emaValue;
+        }
+      }
+
+      lastValue = step(target, lastValue, rateLimit, hysteresisBand, adaptiveSlopeInternal);
+      return lastValue;
+    }
+
+    int getEMA() const { return emaValue; }
+
+    void setRateLimit(int limit) { rateLimit = limit; }
+    void setHysteresisBand(int band) { hysteresisBand = band; }
+
+    void setAdaptiveSlope(int slope)
+    {
+      // Convert the slope from a percentage to a scale of 128 for efficient calculation
+      adaptiveSlopeInternal = (slope * 128 + 50) / 100;
+    }
+
+    void reset()
+    {
+      isFirstCall = true;
+      lastValue = 0;
+      emaValue = 0;
+    }
+
+    /**
+     * One limiter update after the first call, SRL_limitStep with the enabled stages. The disabled stages are
+     * removed by the compiler, and the rate, band and slope fold into the code when they are constants.
+     */
+    static inline int step(int currentValue, int last, int rate, int band, int slopeInternal)
+    {
+      return SRL_limitStep<Adaptive, Hysteresis>(currentValue, last, rate, band, slopeInternal);
+    }
+
+    static inline int updateEMA(int newValue, int currentEMA)
+    {
+      // Same bit-shifting EMA as SlewRateLimiter::updateEMA, with a constant exponent
+      return (newValue * (1 << Exponent) + currentEMA * 1024 - currentEMA * (1 << Exponent)) >> 10;
+    }
+
+private:
+    int lastValue;
+    int emaValue;
+    bool isFirstCall;
+    int rateLimit;
+    int hysteresisBand;
+    int adaptiveSlopeInternal;
+};
+
+template <
+    SlewRateLimiter::SRL_SmoothingExponent Exponent,
+    int Rate,
+    int HystBand,
+    int Slope = 0,
+    SlewRateLimiter::SRL_EMAMode Mode = SlewRateLimiter::SRL_EMA_OFF
+>
+class ConstSlewRateLimiter 
+{
+public:
+    ConstSlewRateLimiter()
+      : lastValue(0),
+        emaValue(0),
+        isFirstCall(true)
+    {
+    }
+
+    int processValue(int currentValue)
+    {
+      if (isFirstCall)
+      {
+        lastValue = currentValue;
+        emaValue = currentValue;
+        isFirstCall = false;
+        return currentValue;
+      }
+
+      int target = currentValue;
+      if (Mode != SlewRateLimiter::SRL_EMA_OFF)
+      {
+        emaValue = Stages::updateEMA(currentValue, emaValue);
+        if (Mode == SlewRateLimiter::SRL_EMA_DRIVE)
+        {
+          target = emaValue;
+        }
+      }
+
+      lastValue = Stages::step(target, lastValue, Rate, HystBand, SlopeInternal);
+      return lastValue;
+    }
+
+    int getEMA() const { return emaValue; }
+
+    void reset()
+    {
+      isFirstCall = true;
+      lastValue = 0;
+      emaValue = 0;
+    }
+
+private:
+    enum { SlopeInternal = (Slope * 128 + 50) / 100 };
+    typedef StaticSlewRateLimiter<Exponent, SlopeInternal != 0, (HystBand > 0), Mode> Stages;
+
+    int lastValue;
+    int emaValue;
+    bool isFirstCall;
+};
+
+#endif /* SlewRateLimiterStatic_h */
@@ -0,0 +1,72 @@
+/**
+ * @file SlewRateLimiterStep.h
+ * @brief SRL_limitStep, the adaptive slope, rate limiting and hysteresis of one sample.
+ *
+ * This is the one definition of the limiter step shared by SlewRateLimiter (processValue, processValueAt,
+ * processBlock and advance) and the compile-time specialized StaticSlewRateLimiter and ConstSlewRateLimiter
+ * (SlewRateLimiterStatic.h). Adaptive and Hysteresis are template parameters, so a disabled stage generates
+ * no instructions; SlewRateLimiter instantiates both stages and passes its runtime slope and band.
+ *
+ * With SRL_BRANCHLESS the step is clamped with min/max and the hysteresis snap is a mask (see
+ * SlewRateLimiter.h). The results are identical for non-negative rate limits and slopes.
+ */
+
+#ifndef SlewRateLimiterStep_h
+#define SlewRateLimiterStep_h
+
+#include "SlewRateLimiterPlatform.h"
+
+/**
+ * One limiter update after the first call: moves last towards target by at most rate (plus the adaptive term
+ * of slopeInternal, on a scale of 128, when Adaptive) and snaps onto target within band (when Hysteresis).
+ */
+template <bool Adaptive, bool Hysteresis>
+inline int SRL_limitStep(int target, int last, int rate, int band, int slopeInternal)
+{
+  int delta = target - last;
+  int allowedChange = rate;
+
+  // Implement adaptive slope if applicable
+  if (Adaptive)
+  {
+    allowedChange += (abs(delta) * slopeInternal)>>7;
+  }
+
+#ifdef SRL_BRANCHLESS
+  // Clamp the step with min/max, so noisy input cannot cause branch mispredictions. Clamping the step
+  // rather than the output keeps every intermediate in range.
+  int step = (delta < -allowedChange) ? -allowedChange : delta;
+  step = (step > allowedChange) ? allowedChange : step;
+
+  // Hysteresis: within the band, also add the remaining distance, which lands exactly on the input. The
+  // remaining distance is |delta| - allowedChange past the clamp and 0 within it, so the band test can start
+  // from |delta| in parallel with the clamp. The mask keeps the compiler from turning the snap into a branch.
+  int snap = Hysteresis ? -(int)(abs(delta) - allowedChange <= band) : 0;
+  return last + step + ((delta - step) & snap);
+#else
+
+  // Rate limiting
+  if (delta > allowedChange)
+  {
+    last += allowedChange;
+  }
+  else if (delta < -allowedChange)
+  {
+    last -= allowedChange;
+  }
+  else
+  {
+    last = target;
+  }
+
+  // Apply hysteresis
+  if (Hysteresis && abs(target - last) <= band)
+  {
+    last = target;
+  }
+
+  return last;
+#endif
+}
+
+#endif /* SlewRateLimiterStep_h */
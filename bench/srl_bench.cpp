@@ -0,0 +1,757 @@
+/**
+ * @file srl_bench.cpp
+ * @brief Host microbenchmark suite for SlewRateLimiter and its kernels.
+ *
+ * Every benchmark runs a limiter over a fixed input pattern and reports nanoseconds per sample, samples per
+ * second, on x86 cycles per sample measured with rdtsc, and on Linux the branch mispredictions per sample
+ * counted with perf_event_open (reported as -1 where the kernel does not allow it). Each measurement is the
+ * best of several runs.
+ *
+ * When built with SRL_BRANCHLESS (the srl_bench_branchless target), the suite measures the branchless
+ * processValue: compare the branch misses of processValue on the noise pattern (random input) and on the
+ * ramp pattern (smooth input) between the two binaries.
+ *
+ * Input patterns:
+ * - step: A periodic step between two levels, so the limiter ramps and then holds.
+ * - ramp: A slow sawtooth, mostly inside the rate limit.
+ * - noise: Uniform noise around a level, the worst case for branch prediction.
+ * - square: A full-scale square wave that keeps the limiter saturated.
+ *
+ * Usage: srl_bench [--json] [--quick] [--filter <substring>] [--mapped-file <path>]
+ *   --json         Print the results as a JSON array (for tracking regressions between releases).
+ *   --quick        Fewer and shorter runs.
+ *   --filter       Only run benchmarks whose name contains the substring.
+ *   --mapped-file  The file for the mapped-startup benchmark (default: srl_bench_mapped.bin in $TMPDIR, or
+ *                  /tmp). It is created, and removed at the end.
+ */
+
+#include "BasicSlewRateLimiter.h"
+#include "FractionalSlewRateLimiter.h"
+#include "LazySlewRateLimiter.h"
+#include "SlewRateLimiter.h"
+#include "SlewRateLimiterBank.h"
+#include "SlewRateLimiterBank16.h"
+#include "SlewRateLimiterGroup.h"
+#include "SlewRateLimiterKernels.h"
+#include "SlewRateLimiterMappedBank.h"
+#include "SlewRateLimiterScheduler.h"
+#include "SlewRateLimiterStatic.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define SRL_BENCH_HAVE_RDTSC 1
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define SRL_BENCH_HAVE_PERF 1
+#endif
+
+namespace {
+
+const size_t PATTERN_LENGTH = 4096;
+const size_t BANK_CHANNELS = 4096;
+
+struct Options
+{
+    bool json;
+    bool quick;
+    std::string filter;
+    std::string mappedFile;
+};
+
+struct Result
+{
+    std::string name;
+    std::string kernel;
+    std::string pattern;
+    std::string config;
+    double nsPerSample;
+    double samplesPerSecond;
+    double cyclesPerSample;
+    double branchMissesPerSample;
+};
+
+struct Config
+{
+    const char* name;
+    SlewRateLimiter::SRL_SmoothingExponent exponent;
+    int rate;
+    int hystBand;
+    int slope;
+    SlewRateLimiter::SRL_EMAMode mode;
+};
+
+struct Pattern
+{
+    const char* name;
+    std::vector<int> values;
+};
+
+Options options;
+std::vector<Result> results;
+volatile int sink;
+
+uint64_t readCycles()
+{
+#ifdef SRL_BENCH_HAVE_RDTSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Counts the branch mispredictions of this thread in user space, if the kernel allows it.
+ */
+class BranchMissCounter
+{
+public:
+    BranchMissCounter() : fd(-1)
+    {
+#ifdef SRL_BENCH_HAVE_PERF
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        if (fd >= 0)
+        {
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    ~BranchMissCounter()
+    {
+#ifdef SRL_BENCH_HAVE_PERF
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+#endif
+    }
+
+    bool available() const
+    {
+        return fd >= 0;
+    }
+
+    uint64_t read() const
+    {
+        uint64_t count = 0;
+#ifdef SRL_BENCH_HAVE_PERF
+        if (fd >= 0 && ::read(fd, &count, sizeof(count)) != (ssize_t)sizeof(count))
+        {
+            count = 0;
+        }
+#endif
+        return count;
+    }
+
+private:
+    int fd;
+};
+
+BranchMissCounter& branchMisses()
+{
+    static BranchMissCounter counter;
+    return counter;
+}
+
+unsigned nextRandom(unsigned& state)
+{
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+std::vector<Pattern> makePatterns()
+{
+    std::vector<Pattern> patterns(4);
+    patterns[0].name = "step";
+    patterns[1].name = "ramp";
+    patterns[2].name = "noise";
+    patterns[3].name = "square";
+
+    unsigned state = 12345;
+    for (size_t i = 0; i < PATTERN_LENGTH; i++)
+    {
+        patterns[0].values.push_back((i / 512) % 2 ? 1000 : 0);
+        patterns[1].values.push_back((int)(i * 3) % 4000);
+        patterns[2].values.push_back(2000 + (int)(nextRandom(state) % 1001) - 500);
+        patterns[3].values.push_back((i / 64) % 2 ? 30000 : -30000);
+    }
+    return patterns;
+}
+
+std::vector<Config> makeConfigs()
+{
+    std::vector<Config> configs;
+    Config fixed = { "fixed", SlewRateLimiter::SRL_SMOOTHING_4, 5, 0, 0, SlewRateLimiter::SRL_EMA_TRACK };
+    Config fixedHyst = { "fixed+hyst", SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0, SlewRateLimiter::SRL_EMA_TRACK };
+    Config adaptive = { "adaptive", SlewRateLimiter::SRL_SMOOTHING_4, 5, 0, 50, SlewRateLimiter::SRL_EMA_TRACK };
+    Config adaptiveHyst = { "adaptive+hyst", SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 50, SlewRateLimiter::SRL_EMA_TRACK };
+    Config emaOff = { "fixed+hyst/ema-off", SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0, SlewRateLimiter::SRL_EMA_OFF };
+    Config emaDrive = { "fixed+hyst/ema-drive", SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0, SlewRateLimiter::SRL_EMA_DRIVE };
+    configs.push_back(fixed);
+    configs.push_back(fixedHyst);
+    configs.push_back(adaptive);
+    configs.push_back(adaptiveHyst);
+    configs.push_back(emaOff);
+    configs.push_back(emaDrive);
+    return configs;
+}
+
+std::vector<Config> makeExponentConfigs()
+{
+    static const char* names[] = {
+        "exp1", "exp2", "exp4", "exp8", "exp16", "exp32", "exp64", "exp128", "exp256", "exp512"
+    };
+    std::vector<Config> configs;
+    for (int e = SlewRateLimiter::SRL_SMOOTHING_1; e <= SlewRateLimiter::SRL_SMOOTHING_512; e++)
+    {
+        Config config = { names[e], (SlewRateLimiter::SRL_SmoothingExponent)e, 5, 2, 0, SlewRateLimiter::SRL_EMA_TRACK };
+        configs.push_back(config);
+    }
+    return configs;
+}
+
+SlewRateLimiter makeLimiter(const Config& config)
+{
+    return SlewRateLimiter(config.exponent, config.rate, config.hystBand, config.slope, config.mode);
+}
+
+bool selected(const std::string& name)
+{
+    return options.filter.empty() || name.find(options.filter) != std::string::npos;
+}
+
+/**
+ * Times body() and records the best run. body processes samplesPerRun samples per call.
+ */
+template <typename Body>
+void measure(const std::string& kernel, const std::string& pattern, const std::string& config,
+             size_t samplesPerRun, Body body)
+{
+    std::string name = kernel + "/" + pattern + "/" + config;
+    if (!selected(name))
+    {
+        return;
+    }
+
+    const int runs = options.quick ? 3 : 7;
+    const double minSeconds = options.quick ? 0.002 : 0.02;
+
+    // Calibrate the number of repetitions so each run lasts at least minSeconds
+    size_t repetitions = 1;
+    for (;;)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < repetitions; r++)
+        {
+            body();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() >= minSeconds || repetitions >= ((size_t)1 << 24))
+        {
+            break;
+        }
+        repetitions *= 2;
+    }
+
+    double bestSeconds = 1e30;
+    double bestCycles = 0;
+    double bestMisses = 0;
+    for (int run = 0; run < runs; run++)
+    {
+        uint64_t missStart = branchMisses().read();
+        uint64_t cycleStart = readCycles();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < repetitions; r++)
+        {
+            body();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        uint64_t cycles = readCycles() - cycleStart;
+        uint64_t misses = branchMisses().read() - missStart;
+        if (elapsed.count() < bestSeconds)
+        {
+            bestSeconds = elapsed.count();
+            bestCycles = (double)cycles;
+            bestMisses = (double)misses;
+        }
+    }
+
+    double samples = (double)samplesPerRun * (double)repetitions;
+    Result result;
+    result.name = name;
+    result.kernel = kernel;
+    result.pattern = pattern;
+    result.config = config;
+    result.nsPerSample = bestSeconds * 1e9 / samples;
+    result.samplesPerSecond = samples / bestSeconds;
+    result.cyclesPerSample = bestCycles / samples;
+    result.branchMissesPerSample = branchMisses().available() ? bestMisses / samples : -1;
+    results.push_back(result);
+
+    if (!options.json)
+    {
+        std::printf("%-58s %9.3f ns/sample %12.0f samples/s %8.2f cycles/sample %7.3f misses/sample\n",
+                    name.c_str(), result.nsPerSample, result.samplesPerSecond, result.cyclesPerSample,
+                    result.branchMissesPerSample);
+        std::fflush(stdout);
+    }
+}
+
+void benchProcessValue(const Pattern& pattern, const Config& config)
+{
+    SlewRateLimiter limiter = makeLimiter(config);
+    const int* values = &pattern.values[0];
+    measure("processValue", pattern.name, config.name, PATTERN_LENGTH, [&]() {
+        int acc = 0;
+        for (size_t i = 0; i < PATTERN_LENGTH; i++)
+        {
+            acc += limiter.processValue(values[i]);
+        }
+        sink = acc;
+    });
+}
+
+void benchProcessValueAt(const Pattern& pattern, const Config& config)
+{
+    // A 10 kHz loop with +/- 20 us of jitter; the timestamps are precomputed so only the limiter is timed
+    SlewRateLimiter limiter = makeLimiter(config);
+    limiter.setRateLimitPerSecond((unsigned long)config.rate * 10000);
+    std::vector<unsigned long> timestamps(PATTERN_LENGTH);
+    unsigned state = 5;
+    unsigned long now = 0;
+    for (size_t i = 0; i < PATTERN_LENGTH; i++)
+    {
+        now += 80 + nextRandom(state) % 41;
+        timestamps[i] = now;
+    }
+    const int* values = &pattern.values[0];
+    measure("processValueAt", pattern.name, config.name, PATTERN_LENGTH, [&]() {
+        int acc = 0;
+        for (size_t i = 0; i < PATTERN_LENGTH; i++)
+        {
+            acc += limiter.processValueAt(values[i], timestamps[i]);
+        }
+        sink = acc;
+    });
+}
+
+void benchLazy(const Pattern& pattern, const Config& config)
+{
+    // Targets written every 10 us against a declared 1 ms tick, and read once per pattern: samples are writes
+    LazySlewRateLimiter limiter(1000, config.exponent, config.rate, config.hystBand, config.slope, config.mode);
+    const int* values = &pattern.values[0];
+    unsigned long now = 0;
+    measure("lazy", pattern.name, config.name, PATTERN_LENGTH, [&]() {
+        for (size_t i = 0; i < PATTERN_LENGTH; i++)
+        {
+            now += 10;
+            limiter.setTarget(values[i], now);
+        }
+        sink = limiter.getValue(now);
+    });
+}
+
+void benchAdvance(const Pattern& pattern, const Config& config)
+{
+    // Every pattern value is held for HOLD samples: one advance call against HOLD processValue calls
+    const unsigned long HOLD = 1000;
+    const size_t steps = 256;
+    SlewRateLimiter limiter = makeLimiter(config);
+    const int* values = &pattern.values[0];
+    measure("advance", pattern.name, config.name, steps * HOLD, [&]() {
+        int acc = 0;
+        for (size_t i = 0; i < steps; i++)
+        {
+            acc += limiter.advance(values[i * (PATTERN_LENGTH / steps)], HOLD);
+        }
+        sink = acc;
+    });
+}
+
+void benchProcessBlock(const Pattern& pattern, const Config& config)
+{
+    SlewRateLimiter limiter = makeLimiter(config);
+    std::vector<int> output(PATTERN_LENGTH);
+    measure("processBlock", pattern.name, config.name, PATTERN_LENGTH, [&]() {
+        limiter.processBlock(&pattern.values[0], &output[0], PATTERN_LENGTH);
+        sink = output[PATTERN_LENGTH - 1];
+    });
+}
+
+void benchFractional(const Pattern& pattern, const Config& config)
+{
+    // Same configuration, with 1/40 unit per sample added to the rate limit
+    FractionalSlewRateLimiter limiter(config.exponent, config.rate, config.hystBand, config.slope, config.mode);
+    limiter.setRateLimitFraction(config.rate * 40L + 1, 40);
+    const int* values = &pattern.values[0];
+    measure("FractionalSlewRateLimiter", pattern.name, config.name, PATTERN_LENGTH, [&]() {
+        int acc = 0;
+        for (size_t i = 0; i < PATTERN_LENGTH; i++)
+        {
+            acc += limiter.processValue(values[i]);
+        }
+        sink = acc;
+    });
+}
+
+void benchStatic(const Pattern& pattern)
+{
+    ConstSlewRateLimiter<SlewRateLimiter::SRL_SMOOTHING_4, 5, 2> limiter;
+    const int* values = &pattern.values[0];
+    measure("ConstSlewRateLimiter", pattern.name, "fixed+hyst", PATTERN_LENGTH, [&]() {
+        int acc = 0;
+        for (size_t i = 0; i < PATTERN_LENGTH; i++)
+        {
+            acc += limiter.processValue(values[i]);
+        }
+        sink = acc;
+    });
+}
+
+template <typename T>
+void benchBasic(const char* kernel, const Pattern& pattern)
+{
+    BasicSlewRateLimiter<T> limiter(SlewRateLimiter::SRL_SMOOTHING_4, 5, 2);
+    std::vector<T> values(pattern.values.begin(), pattern.values.end());
+    measure(kernel, pattern.name, "fixed+hyst", PATTERN_LENGTH, [&]() {
+        T acc = 0;
+        for (size_t i = 0; i < PATTERN_LENGTH; i++)
+        {
+            acc += limiter.processValue(values[i]);
+        }
+        sink = (int)acc;
+    });
+}
+
+void benchBank(SRL_Kernel kernel, const Pattern& pattern, const Config& config)
+{
+    if (!SRL_forceKernel(kernel))
+    {
+        return;
+    }
+
+    // Every channel sees the pattern with a per-channel phase, one pattern sample per tick
+    SlewRateLimiterBank bank(BANK_CHANNELS, config.exponent, config.rate, config.hystBand, config.slope, config.mode);
+    const size_t ticks = 64;
+    std::vector<int> inputs(BANK_CHANNELS * ticks);
+    std::vector<int> outputs(BANK_CHANNELS);
+    for (size_t t = 0; t < ticks; t++)
+    {
+        for (size_t c = 0; c < BANK_CHANNELS; c++)
+        {
+            inputs[t * BANK_CHANNELS + c] = pattern.values[(t * 16 + c) % PATTERN_LENGTH];
+        }
+    }
+
+    measure(std::string("bank-") + SRL_kernelName(kernel), pattern.name, config.name, BANK_CHANNELS * ticks, [&]() {
+        for (size_t t = 0; t < ticks; t++)
+        {
+            bank.processAll(&inputs[t * BANK_CHANNELS], &outputs[0]);
+        }
+        sink = outputs[0];
+    });
+
+    SRL_forceKernel(SRL_KERNEL_AUTO);
+}
+
+void benchGroup(const Pattern& pattern, const Config& config)
+{
+    // Same layout as benchBank, with the channels sharing one SRL_Config: 8 bytes of state per channel
+    SRL_Config shared(config.exponent, config.rate, config.hystBand, config.slope, config.mode);
+    SlewRateLimiterGroup group(shared, BANK_CHANNELS);
+    const size_t ticks = 64;
+    std::vector<int> inputs(BANK_CHANNELS * ticks);
+    std::vector<int> outputs(BANK_CHANNELS);
+    for (size_t t = 0; t < ticks; t++)
+    {
+        for (size_t c = 0; c < BANK_CHANNELS; c++)
+        {
+            inputs[t * BANK_CHANNELS + c] = pattern.values[(t * 16 + c) % PATTERN_LENGTH];
+        }
+    }
+
+    measure("group", pattern.name, config.name, BANK_CHANNELS * ticks, [&]() {
+        for (size_t t = 0; t < ticks; t++)
+        {
+            group.processAll(&inputs[t * BANK_CHANNELS], &outputs[0]);
+        }
+        sink = outputs[0];
+    });
+}
+
+void benchBankStates(const Config& config)
+{
+    // Bulk snapshot and restore of a bank, as for a warm restart: samples are channels copied out and back in
+    SlewRateLimiterBank bank(BANK_CHANNELS, config.exponent, config.rate, config.hystBand, config.slope, config.mode);
+    std::vector<SRL_State> states(BANK_CHANNELS);
+    measure("bank-states", "-", config.name, BANK_CHANNELS, [&]() {
+        bank.getStates(&states[0]);
+        bank.setStates(&states[0]);
+        sink = bank.getValue(0);
+    });
+}
+
+#ifdef SRL_HAVE_MAPPED_BANK
+void benchMappedStartup(const Pattern& pattern, const Config& config)
+{
+    // Startup of a 1M-channel bank up to its first tick: reopening the mapped file of the previous run against
+    // rebuilding the state by replaying the last 64 ticks of input history; samples are channels
+    const size_t channels = (size_t)1 << 20;
+    const size_t history = 64;
+    if (!selected(std::string("mapped-startup/") + pattern.name + "/" + config.name)
+        && !selected(std::string("replay-startup/") + pattern.name + "/" + config.name))
+    {
+        return;
+    }
+
+    std::string file = options.mappedFile;
+    if (file.empty())
+    {
+        const char* tmpdir = std::getenv("TMPDIR");
+        file = std::string((tmpdir != NULL && tmpdir[0] != '\0') ? tmpdir : "/tmp") + "/srl_bench_mapped.bin";
+    }
+    const char* path = file.c_str();
+    std::remove(path);
+    {
+        SlewRateLimiterMappedBank mapped(path, channels, config.exponent, config.rate, config.hystBand,
+                                         config.slope, config.mode);
+        if (mapped.bank() == NULL)
+        {
+            std::fprintf(stderr, "mapped-startup: cannot create %s (status %d), skipped\n", path, (int)mapped.status());
+            return;
+        }
+        for (size_t t = 0; t < history; t++)
+        {
+            for (size_t c = 0; c < channels; c++)
+            {
+                mapped.bank()->setInput(c, pattern.values[(t * 16 + c) % PATTERN_LENGTH]);
+            }
+            mapped.bank()->tick();
+        }
+    }
+
+    bool reopenFailed = false;
+    measure("mapped-startup", pattern.name, config.name, channels, [&]() {
+        SlewRateLimiterMappedBank mapped(path, channels, config.exponent, config.rate, config.hystBand,
+                                         config.slope, config.mode);
+        if (mapped.bank() == NULL)
+        {
+            reopenFailed = true;
+            return;
+        }
+        mapped.bank()->tick();
+        sink = mapped.bank()->getValue(channels - 1);
+    });
+    if (reopenFailed)
+    {
+        std::fprintf(stderr, "mapped-startup: reopening %s failed, the result is not valid\n", path);
+    }
+
+    std::vector<int> inputs(channels);
+    std::vector<int> outputs(channels);
+    measure("replay-startup", pattern.name, config.name, channels, [&]() {
+        SlewRateLimiterBank bank(channels, config.exponent, config.rate, config.hystBand, config.slope, config.mode);
+        for (size_t t = 0; t < history; t++)
+        {
+            for (size_t c = 0; c < channels; c++)
+            {
+                inputs[c] = pattern.values[(t * 16 + c) % PATTERN_LENGTH];
+            }
+            bank.processAll(&inputs[0], &outputs[0]);
+        }
+        sink = outputs[channels - 1];
+    });
+    std::remove(path);
+}
+#endif
+
+void benchBankActive(const Pattern& pattern, const Config& config)
+{
+    // 1 in 1000 channels gets a new input every tick (rotating), the rest hold theirs, so only the channels
+    // still ramping or smoothing are active; samples are counted for every channel, as in benchBank
+    SlewRateLimiterBank bank(BANK_CHANNELS, config.exponent, config.rate, config.hystBand, config.slope, config.mode);
+    const size_t ticks = 256;
+    size_t tick = 0;
+    measure("bank-active", pattern.name, config.name, BANK_CHANNELS * ticks, [&]() {
+        for (size_t t = 0; t < ticks; t++, tick++)
+        {
+            for (size_t c = tick % 1000; c < BANK_CHANNELS; c += 1000)
+            {
+                bank.setInput(c, pattern.values[(tick * 16 + c) % PATTERN_LENGTH]);
+            }
+            bank.tick();
+        }
+        sink = bank.getValue(0);
+    });
+}
+
+void benchScheduler(const Pattern& pattern, const Config& config)
+{
+    // The benchBankActive workload on the timing wheel: only the target changes and the settle events cost
+    // anything, and the outputs are only materialized when they are read
+    SlewRateLimiterScheduler scheduler(BANK_CHANNELS, config.exponent, config.rate, config.hystBand, config.slope,
+                                       config.mode);
+    const size_t ticks = 256;
+    size_t tick = 0;
+    measure("scheduler", pattern.name, config.name, BANK_CHANNELS * ticks, [&]() {
+        for (size_t t = 0; t < ticks; t++, tick++)
+        {
+            for (size_t c = tick % 1000; c < BANK_CHANNELS; c += 1000)
+            {
+                scheduler.setTarget(c, pattern.values[(tick * 16 + c) % PATTERN_LENGTH]);
+            }
+            scheduler.tick();
+        }
+        sink = scheduler.getValue(0);
+    });
+}
+
+void benchBank16(SRL_Kernel kernel, const Pattern& pattern, const Config& config)
+{
+    if (!SRL_forceKernel(kernel))
+    {
+        return;
+    }
+
+    // Same layout as benchBank, with int16_t channels
+    SlewRateLimiterBank16 bank(BANK_CHANNELS, config.exponent, (int16_t)config.rate, (int16_t)config.hystBand,
+                               config.slope, config.mode);
+    const size_t ticks = 64;
+    std::vector<int16_t> inputs(BANK_CHANNELS * ticks);
+    std::vector<int16_t> outputs(BANK_CHANNELS);
+    for (size_t t = 0; t < ticks; t++)
+    {
+        for (size_t c = 0; c < BANK_CHANNELS; c++)
+        {
+            inputs[t * BANK_CHANNELS + c] = (int16_t)pattern.values[(t * 16 + c) % PATTERN_LENGTH];
+        }
+    }
+
+    measure(std::string("bank16-") + SRL_kernelName(kernel), pattern.name, config.name, BANK_CHANNELS * ticks, [&]() {
+        for (size_t t = 0; t < ticks; t++)
+        {
+            bank.processAll(&inputs[t * BANK_CHANNELS], &outputs[0]);
+        }
+        sink = outputs[0];
+    });
+
+    SRL_forceKernel(SRL_KERNEL_AUTO);
+}
+
+void printJson()
+{
+    std::printf("[\n");
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const Result& r = results[i];
+        std::printf("  {\"name\": \"%s\", \"kernel\": \"%s\", \"pattern\": \"%s\", \"config\": \"%s\", "
+                    "\"ns_per_sample\": %.4f, \"samples_per_sec\": %.0f, \"cycles_per_sample\": %.3f, "
+                    "\"branch_misses_per_sample\": %.4f}%s\n",
+                    r.name.c_str(), r.kernel.c_str(), r.pattern.c_str(), r.config.c_str(),
+                    r.nsPerSample, r.samplesPerSecond, r.cyclesPerSample, r.branchMissesPerSample,
+                    (i + 1 < results.size()) ? "," : "");
+    }
+    std::printf("]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    options.json = false;
+    options.quick = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--json") == 0)
+        {
+            options.json = true;
+        }
+        else if (std::strcmp(argv[i], "--quick") == 0)
+        {
+            options.quick = true;
+        }
+        else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+        {
+            options.filter = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--mapped-file") == 0 && i + 1 < argc)
+        {
+            options.mappedFile = argv[++i];
+        }
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--json] [--quick] [--filter <substring>] [--mapped-file <path>]\n",
+                         argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<Pattern> patterns = makePatterns();
+    std::vector<Config> configs = makeConfigs();
+    std::vector<Config> exponentConfigs = makeExponentConfigs();
+
+    benchBankStates(configs[1]);
+#ifdef SRL_HAVE_MAPPED_BANK
+    benchMappedStartup(patterns[2], configs[1]);
+#endif
+    for (size_t p = 0; p < patterns.size(); p++)
+    {
+        for (size_t c = 0; c < configs.size(); c++)
+        {
+            benchProcessValue(patterns[p], configs[c]);
+            benchProcessValueAt(patterns[p], configs[c]);
+            benchAdvance(patterns[p], configs[c]);
+            benchLazy(patterns[p], configs[c]);
+            benchProcessBlock(patterns[p], configs[c]);
+            benchFractional(patterns[p], configs[c]);
+        }
+        for (size_t c = 0; c < exponentConfigs.size(); c++)
+        {
+            benchProcessValue(patterns[p], exponentConfigs[c]);
+        }
+        benchStatic(patterns[p]);
+        benchBasic<int16_t>("BasicSlewRateLimiter<int16_t>", patterns[p]);
+        benchBasic<int32_t>("BasicSlewRateLimiter<int32_t>", patterns[p]);
+        benchBasic<int64_t>("BasicSlewRateLimiter<int64_t>", patterns[p]);
+        benchBasic<float>("BasicSlewRateLimiter<float>", patterns[p]);
+        benchBasic<double>("BasicSlewRateLimiter<double>", patterns[p]);
+        benchGroup(patterns[p], configs[1]);
+        benchGroup(patterns[p], configs[3]);
+        benchBankActive(patterns[p], configs[1]);
+        benchBankActive(patterns[p], configs[4]);
+        benchScheduler(patterns[p], configs[1]);
+        benchScheduler(patterns[p], configs[4]);
+        for (int k = SRL_KERNEL_SCALAR; k <= SRL_KERNEL_AVX512; k++)
+        {
+            benchBank((SRL_Kernel)k, patterns[p], configs[1]);
+            benchBank((SRL_Kernel)k, patterns[p], configs[3]);
+            benchBank16((SRL_Kernel)k, patterns[p], configs[1]);
+            benchBank16((SRL_Kernel)k, patterns[p], configs[3]);
+        }
+    }
+
+    if (options.json)
+    {
+        printJson();
+    }
+    return 0;
+}
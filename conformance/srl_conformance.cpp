@@ -0,0 +1,1464 @@
+/**
+ * @file srl_conformance.cpp
+ * @brief Conformance harness: checks every limiter kernel against a golden corpus.
+ *
+ * The corpus (corpus.txt next to this file) holds input streams, each with a parameter set, and the golden
+ * output and EMA of every sample, produced by the reference model in srl_reference.h. The harness replays
+ * every case through:
+ * - the reference model itself (guards the corpus against edits of the model),
+ * - SlewRateLimiter::processValue,
+ * - SlewRateLimiter::processBlock, with irregular block sizes, with separate buffers and in place (isSettled after
+ *   every block as well),
+ * - SlewRateLimiter::advance, holding every corpus input for a random number of samples and comparing with
+ *   the same number of processValue calls,
+ * - SlewRateLimiter::isSettled and ticksToSettle, against stepping a copy of the limiter until its output
+ *   (and in drive mode its EMA) stops changing,
+ * - SlewRateLimiter::processValueAt, with a 64 us period across a 32-bit timestamp wrap-around (where the
+ *   rate per second gives exactly the corpus rate per sample), plus a check that the carried fraction of a
+ *   slow rate adds up exactly under jittery timestamps, and a comparison of the 32-bit (AVR) time scaling with
+ *   the 64-bit one,
+ * - SlewRateLimiter::getState and setState, and the bulk versions of SlewRateLimiterBank: every case is
+ *   stopped halfway, its state copied byte-wise into a fresh limiter (bank), and the rest must match,
+ * - SlewRateLimiterMappedBank (POSIX hosts): every case stopped halfway and resumed from the file, once after
+ *   a clean close and once from a copy taken while the bank was open (a crash), plus the layout checks,
+ * - LazySlewRateLimiter, with writes and reads at random timestamps across a 32-bit wrap-around, against a
+ *   limiter that processes the latest target on every tick of the declared period,
+ * - SRL_WideEMA for 8-, 16- and 32-bit samples, against the same update in 64 bits: random and full-scale
+ *   inputs at every exponent, and exact convergence to a constant input from the opposite extreme,
+ * - BasicSlewRateLimiter<int32_t>, <int64_t>, and <int16_t> and <SRL_Q15> for the cases whose values fit in
+ *   16 bits, plus <int8_t>, <int16_t> and <SRL_Q15> on generated cases that swing between the extremes of
+ *   their sample type,
+ * - BasicSlewRateLimiter<float> and <double>, against SRL_FloatReferenceLimiter within a relative tolerance,
+ *   and exactly against the corpus where the output is integer (no adaptive slope, EMA not driving),
+ * - FractionalSlewRateLimiter with whole-unit rate limits, for the cases whose values fit in 16 bits, plus a
+ *   check that a fractional rate limit ramps by exactly rate * samples, and setRateLimitFraction against a
+ *   64-bit division for denominators up to 2^31 - 1,
+ * - StaticSlewRateLimiter with every stage enabled, instantiated in the EMA mode of each case (output and EMA),
+ * - SlewRateLimiterBank with every kernel the CPU supports (scalar, SSE4.1, AVX2, AVX-512), one bank per
+ *   EMA mode with one channel per case,
+ * - SlewRateLimiterBank16 with every kernel the CPU supports, for the cases whose values fit in 16 bits, with
+ *   each case repeated on several channels so that the 32-lane kernel runs full vectors and a scalar tail,
+ * - SlewRateLimiterGroup, one shared SRL_Config per case with several channels, through processAll and
+ *   processValue,
+ * - SlewRateLimiterScheduler, one per EMA mode with one channel per case, holding every corpus input for a
+ *   random number of ticks (some long enough to cascade through the upper wheel levels) and comparing reads
+ *   and settle events with a limiter per channel that processes its target on every tick,
+ * and exits with a non-zero status on the first kernel that drifts from the golden data.
+ *
+ * Built with SRL_WIDE_EMA (the srl_conformance_wide_ema target), SlewRateLimiter no longer matches the classic
+ * EMA of the corpus. That build checks processValue and processBlock against SRL_WideReferenceLimiter on the
+ * corpus inputs, plus SRL_WideEMA, advance and ticksToSettle, which do not depend on the golden data. In drive
+ * mode the ticksToSettle brute force steps until isSettled(), as the fraction of the wide EMA is not visible
+ * through getEMA().
+ *
+ * Usage: srl_conformance [corpus]            Check every kernel against the corpus.
+ *        srl_conformance --generate <corpus> Regenerate the corpus from the reference model.
+ */
+
+#include "BasicSlewRateLimiter.h"
+#include "FractionalSlewRateLimiter.h"
+#include "LazySlewRateLimiter.h"
+#include "SlewRateLimiter.h"
+#include "SlewRateLimiterBank.h"
+#include "SlewRateLimiterBank16.h"
+#include "SlewRateLimiterEMA.h"
+#include "SlewRateLimiterGroup.h"
+#include "SlewRateLimiterKernels.h"
+#include "SlewRateLimiterMappedBank.h"
+#include "SlewRateLimiterScheduler.h"
+#include "SlewRateLimiterStatic.h"
+#include "srl_reference.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef SRL_HAVE_MAPPED_BANK
+#include <unistd.h>
+#endif
+
+#ifndef SRL_CONFORMANCE_CORPUS
+#define SRL_CONFORMANCE_CORPUS "conformance/corpus.txt"
+#endif
+
+namespace {
+
+struct Case
+{
+    int exponent;
+    int rate;
+    int band;
+    int slope;
+    int mode;
+    std::vector<int> inputs;
+    std::vector<int> outputs;
+    std::vector<int> ema;
+};
+
+struct Checker
+{
+    std::string kernel;
+    long mismatches;
+    long samples;
+
+    explicit Checker(const std::string& name) : kernel(name), mismatches(0), samples(0) {}
+
+    void expect(size_t caseIndex, size_t sample, const char* what, int expected, int actual)
+    {
+        samples++;
+        if (expected != actual)
+        {
+            if (mismatches < 5)
+            {
+                std::printf("  %s: case %zu sample %zu %s: expected %d, got %d\n",
+                            kernel.c_str(), caseIndex, sample, what, expected, actual);
+            }
+            mismatches++;
+        }
+    }
+
+    bool report() const
+    {
+        std::printf("%-24s %8ld checks  %s\n", kernel.c_str(), samples, mismatches ? "FAIL" : "ok");
+        return mismatches == 0;
+    }
+};
+
+unsigned nextRandom(unsigned& state)
+{
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+// ---------------------------------------------------------------------------------------------------------
+// Corpus generation
+
+// Cases whose inputs swing over the whole range [lo, hi] of a narrow sample type, with golden data from the
+// reference model (which does not overflow for inputs of up to 16 bits)
+std::vector<Case> generateRangeCases(int lo, int hi, unsigned seed)
+{
+    static const int rates[] = { 0, 1, 3, 20, 200 };
+    static const int bands[] = { -1, 0, 2, 17 };
+    static const int slopes[] = { 0, 25, 50, 99, 100, 1000 };
+    const size_t samples = 256;
+
+    std::vector<Case> cases;
+    unsigned state = seed;
+    for (int i = 0; i < 60; i++)
+    {
+        Case c;
+        c.exponent = i % 10;
+        c.mode = (i / 10) % 3;
+        c.rate = rates[nextRandom(state) % 5];
+        c.band = bands[nextRandom(state) % 4];
+        c.slope = (i % 4 == 0) ? 0 : slopes[nextRandom(state) % 6];
+        for (size_t s = 0; s < samples; s++)
+        {
+            int x = 0;
+            switch ((i / 30 + s / 64) % 3)
+            {
+                case 0: x = (s / 8) % 2 ? hi : lo; break;                                     // full-scale square
+                case 1: x = lo + (int)(nextRandom(state) % (unsigned)(hi - lo + 1)); break;   // full-scale noise
+                default: x = (nextRandom(state) % 2) ? hi - (int)(s % 3) : lo + (int)(s % 3); break;   // rails
+            }
+            c.inputs.push_back(x);
+        }
+
+        SRL_ReferenceLimiter reference;
+        reference.configure(c.exponent, c.rate, c.band, c.slope, c.mode);
+        for (size_t s = 0; s < samples; s++)
+        {
+            c.outputs.push_back(reference.process(c.inputs[s]));
+            c.ema.push_back(reference.emaValue);
+        }
+        cases.push_back(c);
+    }
+    return cases;
+}
+
+std::vector<Case> generateCases()
+{
+    // Negative rates and slopes are left out: they make allowedChange negative, the output then runs away
+    // and the golden data would depend on int overflow
+    static const int rates[] = { 0, 1, 5, 37, 1000, 20000 };
+    static const int bands[] = { -1, 0, 2, 17, 500 };
+    static const int slopes[] = { 0, 1, 25, 49, 50, 51, 99, 100, 150, 200, 1000 };
+    const size_t samples = 256;
+
+    std::vector<Case> cases;
+    unsigned state = 20231103;
+    for (int i = 0; i < 72; i++)
+    {
+        Case c;
+        c.exponent = i % 10;
+        c.mode = (i / 10) % 3;
+        c.rate = rates[nextRandom(state) % 6];
+        c.band = bands[nextRandom(state) % 5];
+        c.slope = (i % 4 == 0) ? 0 : slopes[nextRandom(state) % 11];
+
+        int pattern = i % 6;
+        for (size_t s = 0; s < samples; s++)
+        {
+            int x = 0;
+            switch (pattern)
+            {
+                case 0: x = (s / 64) % 2 ? 1000 : -200; break;                           // step
+                case 1: x = (int)(s * 7) % 1500; break;                                    // ramp
+                case 2: x = 2000 + (int)(nextRandom(state) % 1001) - 500; break;          // noise
+                case 3: x = (s / 16) % 2 ? 30000 : -30000; break;                          // square
+                case 4: x = (s % 50 == 0) ? 5000 : 0; break;                                // impulses
+                default: x = (int)(nextRandom(state) % 2000001) - 1000000; break;         // full range
+            }
+            c.inputs.push_back(x);
+        }
+
+        SRL_ReferenceLimiter reference;
+        reference.configure(c.exponent, c.rate, c.band, c.slope, c.mode);
+        for (size_t s = 0; s < samples; s++)
+        {
+            c.outputs.push_back(reference.process(c.inputs[s]));
+            c.ema.push_back(reference.emaValue);
+        }
+        cases.push_back(c);
+    }
+    return cases;
+}
+
+void writeArray(FILE* file, const char* tag, const std::vector<int>& values)
+{
+    std::fprintf(file, "%s", tag);
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        std::fprintf(file, " %d", values[i]);
+    }
+    std::fprintf(file, "\n");
+}
+
+bool writeCorpus(const char* path, const std::vector<Case>& cases)
+{
+    FILE* file = std::fopen(path, "w");
+    if (!file)
+    {
+        std::perror(path);
+        return false;
+    }
+    std::fprintf(file, "# SlewRateLimiter conformance corpus, generated by srl_conformance --generate.\n");
+    std::fprintf(file, "# case <exponent> <rate> <band> <slope> <mode> <samples>, then the in, out and ema lines.\n");
+    for (size_t i = 0; i < cases.size(); i++)
+    {
+        const Case& c = cases[i];
+        std::fprintf(file, "case %d %d %d %d %d %zu\n", c.exponent, c.rate, c.band, c.slope, c.mode, c.inputs.size());
+        writeArray(file, "in", c.inputs);
+        writeArray(file, "out", c.outputs);
+        writeArray(file, "ema", c.ema);
+    }
+    std::fclose(file);
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------
+// Corpus loading
+
+bool readArray(FILE* file, const char* tag, size_t count, std::vector<int>& values)
+{
+    char word[16];
+    if (std::fscanf(file, "%15s", word) != 1 || std::strcmp(word, tag) != 0)
+    {
+        return false;
+    }
+    values.resize(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        if (std::fscanf(file, "%d", &values[i]) != 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool readCorpus(const char* path, std::vector<Case>& cases)
+{
+    FILE* file = std::fopen(path, "r");
+    if (!file)
+    {
+        std::perror(path);
+        return false;
+    }
+
+    char line[256];
+    bool ok = true;
+    while (ok && std::fgets(line, sizeof(line), file))
+    {
+        if (line[0] == '#' || line[0] == '\n')
+        {
+            continue;
+        }
+        Case c;
+        size_t count = 0;
+        if (std::sscanf(line, "case %d %d %d %d %d %zu", &c.exponent, &c.rate, &c.band, &c.slope, &c.mode, &count) != 6)
+        {
+            ok = false;
+            break;
+        }
+        ok = readArray(file, "in", count, c.inputs)
+          && readArray(file, "out", count, c.outputs)
+          && readArray(file, "ema", count, c.ema);
+        if (ok)
+        {
+            cases.push_back(c);
+            // Consume the end of the ema line
+            ok = std::fgets(line, sizeof(line), file) != NULL || std::feof(file);
+        }
+    }
+    std::fclose(file);
+
+    if (!ok || cases.empty())
+    {
+        std::fprintf(stderr, "%s: malformed corpus\n", path);
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------
+// Kernels under test
+
+bool checkReference(const std::vector<Case>& cases)
+{
+    Checker check("reference");
+    for (size_t i = 0; i < cases.size(); i++)
+    {
+        const Case& c = cases[i];
+        SRL_ReferenceLimiter reference;
+        reference.configure(c.exponent, c.rate, c.band, c.slope, c.mode);
+        for (size_t s = 0; s < c.inputs.size(); s++)
+        {
+            check.expect(i, s, "output", c.outputs[s], reference.process(c.inputs[s]));
+            check.expect(i, s, "ema", c.ema[s], reference.emaValue);
+        }
+    }
+    return check.report();
+}
+
+SlewRateLimiter makeLimiter(const Case& c)
+{
+    return SlewRateLimiter((SlewRateLimiter::SRL_SmoothingExponent)c.exponent, c.rate, c.band, c.slope,
+                           (SlewRateLimiter::SRL_EMAMode)c.mode);
+}
+
+bool checkProcessValue(const std::vector<Case>& cases)
+{
+    Checker check("processValue");
+    for (size_t i = 0; i < cases.size(); i++)
+    {
+        const Case& c = cases[i];
+        SlewRateLimiter limiter = makeLimiter(c);
+        for (size_t s = 0; s < c.inputs.size(); s++)
+        {
+            check.expect(i, s, "output", c.outputs[s], limiter.processValue(c.inputs[s]));
+            check.expect(i, s, "ema", c.ema[s], limiter.getEMA());
+            check.expect(i, s, "getValue", c.outputs[s], limiter.getValue());
+        }
+    }
+    return check.report();
+}
+
+bool checkProcessBlock(const std::vector<Case>& cases)
+{
+    Checker check("processBlock");
+    unsigned state = 7;
+    for (size_t i = 0; i < cases.size(); i++)
+    {
+        const Case& c = cases[i];
+        SlewRateLimiter limiter = makeLimiter(c);
+        SlewRateLimiter inPlace = makeLimiter(c);
+        SlewRateLimiter single = makeLimiter(c);
+        std::vector<int> outputs(c.inputs.size());
+        // The in-place run overwrites its inputs with its outputs (in == out)
+        std::vector<int> buffer(c.inputs);
+        size_t s = 0;
+        while (s < c.inputs.size())
+        {
+            size_t n = nextRandom(state) % 70;
+            if (n > c.inputs.size() - s)
+            {
+                n = c.inputs.size() - s;
+            }
+            limiter.processBlock(&c.inputs[s], &outputs[s], n);
+            inPlace.processBlock(&buffer[s], &buffer[s], n);
+            for (size_t k = s; k < s + n; k++)
+            {
+                single.processValue(c.inputs[k]);
+            }
+            s += n;
+            check.expect(i, s - 1, "isSettled", single.isSettled(), limiter.isSettled());
+            check.expect(i, s - 1, "in-place isSettled", single.isSettled(), inPlace.isSettled());
+        }
+        for (s = 0; s < c.inputs.size(); s++)
+        {
+            check.expect(i, s, "output", c.outputs[s], outputs[s]);
+            check.expect(i, s, "in-place output", c.outputs[s], buffer[s]);
+        }
+        check.expect(i, c.inputs.size() - 1, "ema", c.ema.back(), limiter.getEMA());
+        check.expect(i, c.inputs.size() - 1, "in-place ema", c.ema.back(), inPlace.getEMA());
+    }
+    return check.report();
+}
+
+bool checkAdvance(const std::vector<Case>& cases)
+{
+    Checker check("advance");
+    unsigned state = 11;
+    for (size_t i = 0; i < cases.size(); i++)
+    {
+        const Case& c = cases[i];
+        SlewRateLimiter fast = makeLimiter(c);
+        SlewRateLimiter slow = makeLimiter(c);
+        for (size_t s = 0; s < c.inputs.size(); s++)
+        {
+            // Mostly short holds, sometimes long enough for the EMA to settle
+            unsigned long n = nextRandom(state) % 8;
+            n = (n == 0) ? nextRandom(state) % 20000 : n;
+            int expected = 0;
+            for (unsigned long k = 0; k < n; k++)
+            {
+                expected = slow.processValue(c.inputs[s]);
+            }
+            int actual = fast.advance(c.inputs[s], n);
+            if (n > 0)
+            {
+                check.expect(i, s, "output", expected, actual);
+            }
+            check.expect(i, s, "ema", slow.getEMA(), fast.getEMA());
+        }
+        check.expect(i, c.inputs.size(), "final", slow.processValue(0), fast.processValue(0));
+    }
+    return check.report();
+}
+
+// Steps a copy of the limiter with a constant input and returns the first tick after which the output (and in
+// drive mode the EMA) no longer changes, with the output on the input (drive mode: on the EMA)
+unsigned long bruteForceTicksToSettle(SlewRateLimiter limiter, int target, int mode)
+{
+    const unsigned long horizon = 40000;
+#ifdef SRL_WIDE_EMA
+    // The fraction of the wide EMA keeps moving after getEMA() has stopped, and only isSettled() can see it
+    if (mode == SlewRateLimiter::SRL_EMA_DRIVE)
+    {
+        for (unsigned long k = 1; k <= horizon; k++)
+        {
+            limiter.processValue(target);
+            if (limiter.isSettled())
+            {
+                return k;
+            }
+        }
+        return SRL_NEVER_SETTLES;
+    }
+#endif
+    std::vector<int> outputs;
+    std::vector<int> ema;
+    for (unsigned long k = 0; k <= horizon; k++)
+    {
+        outputs.push_back(k == 0 ? 0 : limiter.processValue(target));
+        ema.push_back(limiter.getEMA());
+    }
+    int settledOutput = (mode == SlewRateLimiter::SRL_EMA_DRIVE) ? ema[horizon] : target;
+    if (outputs[horizon] != settledOutput)
+    {
+        return SRL_NEVER_SETTLES;
+    }
+    unsigned long k = horizon;
+    while (k > 1 && outputs[k - 1] == settledOutput
+           && (mode != SlewRateLimiter::SRL_EMA_DRIVE || ema[k - 1] == ema[horizon]))
+    {
+        k--;
+    }
+    return k;
+}
+
+bool checkSettle(const std::vector<Case>& cases)
+{
+    Checker check("ticksToSettle");
+    unsigned state = 17;
+    for (size_t i = 0; i < cases.size(); i++)
+    {
+        const Case& c = cases[i];
+        SlewRateLimiter limiter = makeLimiter(c);
+        for (size_t s = 0; s < c.inputs.size(); s++)
+        {
+            limiter.processValue(c.inputs[s]);
+            if (s % 16 != 5)
+            {
+                continue;
+            }
+            int target = c.inputs[nextRandom(state) % c.inputs.size()];
+            unsigned long expected = bruteForceTicksToSettle(limiter, target, c.mode);
+            // The brute force cannot tell "settled now" (0) from "settled after one tick" (1)
+            unsigned long actual = limiter.ticksToSettle(target);
+            if (expected == 1 && actual == 0)
+            {
+                actual = 1;
+            }
+            check.expect(i, s, "ticks", (int)expected, (int)actual);
+
+            SlewRateLimiter copy(limiter);
+            unsigned long ticks = copy.ticksToSettle(c.inputs[s]);
+            check.expect(i, s, "isSettled", ticks == 0, copy.isSettled());
+            if (ticks != SRL_NEVER_SETTLES)
+            {
+                copy.advance(c.inputs[s], ticks);
+                check.expect(i, s, "settled", 1, copy.isSettled());
+            }
+        }
+    }
+    return check.report();
+}
+
+bool checkProcessValueAt(const std::vector<Case>& cases)
+{
+    Checker check("processValueAt");
+    const unsigned long period = 64;
+    for (size_t i = 0; i < cases.size(); i++)
+    {
+        const Case& c = cases[i];
+        SlewRateLimiter limiter = makeLimiter(c);
+        limiter.setRateLimitPerSecond((unsigned long)c.rate * (1000000 / period));
+        uint32_t timestamp = 0xFFFFFFFFUL - 100 * period;
+        for (size_t s = 0; s < c.inputs.size(); s++)
+        {
+            check.expect(i, s, "output", c.outputs[s], limiter.processValueAt(c.inputs[s], timestamp));
+            check.expect(i, s, "ema", c.ema[s], limiter.getEMA());
+            timestamp += period;
+        }
+    }
+
+    // 250 units per second for one second, in calls 50 .. 150 us apart: the output must reach exactly 250
+    SlewRateLimiter limiter(SlewRateLimiter::SRL_SMOOTHING_4, 0, 0, 0, SlewRateLimiter::SRL_EMA_OFF);
+    limiter.setRateLimitPerSecond(250);
+    unsigned state = 99;
+    unsigned long timestamp = 0;
+    limiter.processValueAt(0, timestamp);
+    int output = 0;
+    while (timestamp < 1000000 - 150)
+    {
+        timestamp += 50 + nextRandom(state) % 101;
+        output = limiter.processValueAt(1000, timestamp);
+    }
+    output = limiter.processValueAt(1000, 1000000);
+    check.expect(cases.size(), 0, "carry", 250, output);
+
+    // The 32-bit (AVR) time scaling against the 64-bit one, carry chained across calls: small and large gaps,
+    // around the 2^16 boundaries of both paths, and extreme rates
+    static const uint32_t edges[] = { 0, 1, 0xFFFE, 0xFFFF, 0x10000, 0xFFFFFFFFUL };
+    uint32_t carry32 = 0;
+    uint32_t carry64 = 0;
+    for (size_t k = 0; k < 200000; k++)
+    {
+        unsigned r = nextRandom(state);
+        uint32_t elapsed = (r % 8 == 0) ? edges[nextRandom(state) % 6] : (r % 8 == 1) ? nextRandom(state) << 8
+                         : nextRandom(state) % 70000;
+        uint32_t whole = (r % 5 == 0) ? edges[nextRandom(state) % 6] : nextRandom(state) % 4;
+        uint32_t fraction = (r % 7 == 0) ? edges[nextRandom(state) % 6] : (nextRandom(state) << 8) ^ nextRandom(state);
+        uint32_t units32 = SRL_scaleRate32(elapsed, whole, fraction, carry32);
+        uint32_t units64 = SRL_scaleRate64(elapsed, whole, fraction, carry64);
+        check.expect(cases.size() + 1, k, "scaleRate32 units", 1, units32 == units64);
+        check.expect(cases.size() + 1, k, "scaleRate32 carry", 1, carry32 == carry64);
+    }
+    return check.report();
+}
+
+bool checkState(const std::vector<Case>& cases)
+{
+    Checker check("state");
+    for (size_t i = 0; i < cases.size(); i++)
+    {
+        const Case& c = cases[i];
+        size_t half = c.inputs.size() / 2;
+
+        // A fresh limiter round-trips the first-call state
+        SlewRateLimiter limiter = makeLimiter(c);
+        SlewRateLimiter restored = makeLimiter(c);
+        restored.processValue(12345);
+        restored.setState(limiter.getState());
+        check.expect(i, 0, "first", c.outputs[0], restored.processValue(c.inputs[0]));
+
+        // Stop halfway and restore into a fresh limiter through raw bytes, as a warm restart would
+        limiter = makeLimiter(c);
+        for (size_t s = 0; s < half; s++)
+        {
+            limiter.processValue(c.inputs[s]);
+        }
+        SRL_State saved = limiter.getState();
+        unsigned char bytes[sizeof(SRL_State)];
+        std::memcpy(bytes, &saved, sizeof(bytes));
+        SRL_State loaded;
+        std::memcpy(&loaded, bytes, sizeof(bytes));
+        restored = makeLimiter(c);
+        restored.setState(loaded);
+        for (size_t s = half; s < c.inputs.size(); s++)
+        {
+            check.expect(i, s, "output", c.outputs[s], restored.processValue(c.inputs[s]));
+            check.expect(i, s, "ema", c.ema[s], restored.getEMA());
+        }
+    }
+
+    // The bank: every case on its own channel, one bank per EMA mode, restored in bulk halfway
+    size_t samples = cases[0].inputs.size();
+    for (int mode = SlewRateLimiter::SRL_EMA_TRACK; mode <= SlewRateLimiter::SRL_EMA_DRIVE; mode++)
+    {
+        std::vector<size_t> members;
+        for (size_t i = 0; i < cases.size(); i++)
+        {
+            if (cases[i].mode == mode && cases[i].inputs.size() == samples)
+            {
+                members.push_back(i);
+            }
+        }
+        if (members.empty())
+        {
+            continue;
+        }
+
+        SlewRateLimiterBank before(members.size(), SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0,
+                                   (SlewRateLimiter::SRL_EMAMode)mode);
+        SlewRateLimiterBank after(members.size(), SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0,
+                                  (SlewRateLimiter::SRL_EMAMode)mode);
+        for (size_t m = 0; m < members.size(); m++)
+        {
+            const Case& c = cases[members[m]];
+            before.setSmoothingExponent(m, (SlewRateLimiter::SRL_SmoothingExponent)c.exponent);
+            before.setRateLimit(m, c.rate);
+            before.setHysteresisBand(m, c.band);
+            before.setAdaptiveSlope(m, c.slope);
+            after.setSmoothingExponent(m, (SlewRateLimiter::SRL_SmoothingExponent)c.exponent);
+            after.setRateLimit(m, c.rate);
+            after.setHysteresisBand(m, c.band);
+            after.setAdaptiveSlope(m, c.slope);
+        }
+
+        for (size_t s = 0; s < samples / 2; s++)
+        {
+            for (size_t m = 0; m < members.size(); m++)
+            {
+                before.setInput(m, cases[members[m]].inputs[s]);
+            }
+            before.tick();
+        }
+
+        // The first channel is reset, so the first-call state goes through the snapshot too
+        before.reset(0);
+        std::vector<SRL_State> snapshot(members.size());
+        before.getStates(&snapshot[0]);
+        after.setStates(&snapshot[0]);
+        for (size_t s = samples / 2; s < samples; s++)
+        {
+            for (size_t m = 0; m < members.size(); m++)
+            {
+                after.setInput(m, cases[members[m]].inputs[m == 0 ? s - samples / 2 : s]);
+            }
+            after.tick();
+            for (size_t m = 0; m < members.size(); m++)
+            {
+                const Case& c = cases[members[m]];
+                size_t k = (m == 0) ? s - samples / 2 : s;
+                check.expect(members[m], s, "bank output", c.outputs[k], after.getValue(m));
+                check.expect(members[m], s, "bank ema", c.ema[k], after.getEMA(m));
+            }
+        }
+    }
+    return check.report();
+}
+
+#ifdef SRL_HAVE_MAPPED_BANK
+// Configures channel m of a bank like case members[m]
+void configureChannels(SlewRateLimiterBank& bank, const std::vector<Case>& cases, const std::vector<size_t>& members)
+{
+    for (size_t m = 0; m < members.size(); m++)
+    {
+        const Case& c = cases[members[m]];
+        bank.setSmoothingExponent(m, (SlewRateLimiter::SRL_SmoothingExponent)c.exponent);
+        bank.setRateLimit(m, c.rate);
+        bank.setHysteresisBand(m, c.band);
+        bank.setAdaptiveSlope(m, c.slope);
+    }
+}
+
+// Runs samples [begin, end) of the member cases through the bank and checks them against the golden data
+void runChannels(Checker& check, SlewRateLimiterBank& bank, const std::vector<Case>& cases,
+                 const std::vector<size_t>& members, size_t begin, size_t end)
+{
+    for (size_t s = begin; s < end; s++)
+    {
+        for (size_t m = 0; m < members.size(); m++)
+        {
+            bank.setInput(m, cases[members[m]].inputs[s]);
+        }
+        bank.tick();
+        for (size_t m = 0; m < members.size(); m++)
+        {
+            check.expect(members[m], s, "output", cases[members[m]].outputs[s], bank.getValue(m));
+            check.expect(members[m], s, "ema", cases[members[m]].ema[s], bank.getEMA(m));
+        }
+    }
+}
+
+bool copyFile(const char* from, const char* to)
+{
+    FILE* in = std::fopen(from, "rb");
+    FILE* out = std::fopen(to, "wb");
+    bool ok = in != NULL && out != NULL;
+    char buffer[4096];
+    size_t n;
+    while (ok && (n = std::fread(buffer, 1, sizeof(buffer), in)) > 0)
+    {
+        ok = std::fwrite(buffer, 1, n, out) == n;
+    }
+    if (in != NULL)
+    {
+        std::fclose(in);
+    }
+    if (out != NULL)
+    {
+        ok = (std::fclose(out) == 0) && ok;
+    }
+    return ok;
+}
+
+bool checkMappedBank(const std::vector<Case>& cases)
+{
+    Checker check("mapped-bank");
+    char path[] = "/tmp/srl_conformance_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0)
+    {
+        std::printf("  mapped-bank: cannot create a temporary file\n");
+        return false;
+    }
+    close(fd);
+    std::string crashPath = std::string(path) + ".crash";
+
+    size_t samples = cases[0].inputs.size();
+    size_t half = samples / 2;
+    for (int mode = SlewRateLimiter::SRL_EMA_TRACK; mode <= SlewRateLimiter::SRL_EMA_DRIVE; mode++)
+    {
+        std::vector<size_t> members;
+        for (size_t i = 0; i < cases.size(); i++)
+        {
+            if (cases[i].mode == mode && cases[i].inputs.size() == samples)
+            {
+                members.push_back(i);
+            }
+        }
+        if (members.empty())
+        {
+            continue;
+        }
+        SlewRateLimiter::SRL_EMAMode emaMode = (SlewRateLimiter::SRL_EMAMode)mode;
+        std::remove(path);
+
+        // First half, a copy of the open file as a crash would leave it, then a clean close
+        {
+            SlewRateLimiterMappedBank mapped(path, members.size(), SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0, emaMode);
+            check.expect(members[0], 0, "created", SRL_MAPPED_CREATED, mapped.status());
+            if (mapped.bank() == NULL)
+            {
+                break;
+            }
+            configureChannels(*mapped.bank(), cases, members);
+            runChannels(check, *mapped.bank(), cases, members, 0, half);
+            check.expect(members[0], half, "copy", 1, copyFile(path, crashPath.c_str()));
+        }
+
+        // Second half, once from the cleanly closed file and once from the crash copy
+        for (int crashed = 0; crashed <= 1; crashed++)
+        {
+            const char* file = crashed ? crashPath.c_str() : path;
+            SlewRateLimiterMappedBank mapped(file, members.size(), SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0, emaMode);
+            check.expect(members[0], half, "status", crashed ? SRL_MAPPED_RECOVERED : SRL_MAPPED_RESUMED,
+                         mapped.status());
+            if (mapped.bank() == NULL)
+            {
+                break;
+            }
+            configureChannels(*mapped.bank(), cases, members);
+            runChannels(check, *mapped.bank(), cases, members, half, samples);
+        }
+
+        // A file for another channel count is refused, and left as it is
+        SlewRateLimiterMappedBank other(path, members.size() + 1);
+        check.expect(members[0], samples, "layout", SRL_MAPPED_ERROR_LAYOUT, other.status());
+        check.expect(members[0], samples, "no bank", 1, other.bank() == NULL);
+    }
+    std::remove(path);
+    std::remove(crashPath.c_str());
+    return check.report();
+}
+#endif
+
+bool checkLazy(const std::vector<Case>& cases)
+{
+    Checker check("lazy");
+    const uint32_t period = 100;
+    unsigned state = 31;
+    for (size_t i = 0; i < cases.size(); i++)
+    {
+        const Case& c = cases[i];
+        LazySlewRateLimiter lazy(period, (SlewRateLimiter::SRL_SmoothingExponent)c.exponent, c.rate, c.band, c.slope,
+                                 (SlewRateLimiter::SRL_EMAMode)c.mode);
+        SlewRateLimiter ticked = makeLimiter(c);
+        uint32_t timestamp = 0xFFFFFFFFUL - 1000 * period + nextRandom(state) % period;
+        uint32_t nextTick = timestamp + period;
+        int target = c.inputs[0];
+        lazy.setTarget(target, timestamp);
+
+        for (size_t s = 1; s < c.inputs.size(); s++)
+        {
+            // Gaps from well within one tick (several writes per tick) to many ticks, some landing on a tick
+            uint32_t gap = nextRandom(state) % 4 == 0 ? nextRandom(state) % (50 * period) : nextRandom(state) % period;
+            gap = (nextRandom(state) % 8 == 0) ? nextTick - timestamp : gap;
+            timestamp += gap;
+            while ((int32_t)(timestamp - nextTick) >= 0)
+            {
+                ticked.processValue(target);
+                nextTick += period;
+            }
+            if (nextRandom(state) % 3 == 0)
+            {
+                check.expect(i, s, "output", ticked.advance(target, 0), lazy.getValue(timestamp));
+                check.expect(i, s, "ema", ticked.getEMA(), lazy.getEMA(timestamp));
+            }
+            target = c.inputs[s];
+            lazy.setTarget(target, timestamp);
+        }
+        for (int k = 0; k < 20; k++)
+        {
+            ticked.processValue(target);
+        }
+        nextTick += 19 * period;
+        check.expect(i, c.inputs.size(), "final", ticked.advance(target, 0), lazy.getValue(nextTick));
+    }
+    return check.report();
+}
+
+// Steps SRL_WideEMA<Sample> and the same update in 64 bits side by side. The accumulators must stay equal (no
+// overflow) and the output must reach a constant input exactly
+template <typename Sample>
+bool checkWideEMA(const char* name)
+{
+    typedef SRL_WideEMA<Sample> EMA;
+    typedef SRL_WideReferenceLimiter Reference;
+    const int64_t lo = -((int64_t)1 << (8 * sizeof(Sample) - 1));
+    const int64_t hi = ((int64_t)1 << (8 * sizeof(Sample) - 1)) - 1;
+    Checker check(name);
+    unsigned state = 29;
+    for (int e = SlewRateLimiter::SRL_SMOOTHING_1; e <= SlewRateLimiter::SRL_SMOOTHING_512; e++)
+    {
+        // Full-scale steps: from each extreme to the other (and through 0 and -1), until the output settles
+        const int64_t levels[] = { lo, hi, 0, lo, -1, hi };
+        for (size_t k = 0; k + 1 < sizeof(levels) / sizeof(levels[0]); k++)
+        {
+            typename EMA::Accumulator acc = EMA::init((Sample)levels[k]);
+            int64_t wide = levels[k] * 1024;
+            check.expect(e, k, "init", 1, (int64_t)acc == wide);
+            size_t n = 0;
+            while (EMA::output(acc) != (Sample)levels[k + 1] && n < 100000)
+            {
+                acc = EMA::update((Sample)levels[k + 1], acc, e);
+                wide = wide + levels[k + 1] * ((int64_t)1 << e) - Reference::sar64(wide, 10 - e);
+                n++;
+            }
+            check.expect(e, n, "accumulator", 1, (int64_t)acc == wide);
+            check.expect(e, n, "converged", (int)levels[k + 1], (int)EMA::output(acc));
+        }
+
+        // Random inputs, half of them at an extreme
+        typename EMA::Accumulator acc = EMA::init(0);
+        int64_t wide = 0;
+        for (size_t s = 0; s < 4096; s++)
+        {
+            unsigned r = nextRandom(state);
+            int64_t x = (r % 4 == 0) ? lo : (r % 4 == 1) ? hi : lo + (int64_t)(nextRandom(state) % (uint64_t)(hi - lo + 1));
+            acc = EMA::update((Sample)x, acc, e);
+            wide = wide + x * ((int64_t)1 << e) - Reference::sar64(wide, 10 - e);
+            check.expect(e, s, "accumulator", 1, (int64_t)acc == wide);
+            check.expect(e, s, "output", (int)Reference::sar64(wide, 10), (int)EMA::output(acc));
+        }
+    }
+    return check.report();
+}
+
+#ifdef SRL_WIDE_EMA
+bool checkWideLimiter(const std::vector<Case>& cases)
+{
+    Checker check("wide-ema");
+    unsigned state = 31;
+    for (size_t i = 0; i < cases.size(); i++)
+    {
+        const Case& c = cases[i];
+        SRL_WideReferenceLimiter reference;
+        reference.configure(c.exponent, c.rate, c.band, c.slope, c.mode);
+        SlewRateLimiter limiter = makeLimiter(c);
+        SlewRateLimiter block = makeLimiter(c);
+        std::vector<int> expected(c.inputs.size());
+        std::vector<int> outputs(c.inputs.size());
+        for (size_t s = 0; s < c.inputs.size(); s++)
+        {
+            expected[s] = reference.process(c.inputs[s]);
+            check.expect(i, s, "output", expected[s], limiter.processValue(c.inputs[s]));
+            check.expect(i, s, "ema", reference.emaValue, limiter.getEMA());
+        }
+        for (size_t s = 0; s < c.inputs.size(); )
+        {
+            size_t n = nextRandom(state) % 70;
+            n = (n > c.inputs.size() - s) ? c.inputs.size() - s : n;
+            block.processBlock(&c.inputs[s], &outputs[s], n);
+            s += n;
+        }
+        for (size_t s = 0; s < c.inputs.size(); s++)
+        {
+            check.expect(i, s, "block output", expected[s], outputs[s]);
+        }
+        check.expect(i, c.inputs.size(), "block ema", reference.emaValue, block.getEMA());
+
+        // Held at a constant input, the EMA reaches it exactly (the classic EMA stops short of a rising input);
+        // in the off mode it kept the first input, which is the one held here
+        for (int k = 0; k < 40000; k++)
+        {
+            limiter.processValue(c.inputs[0]);
+        }
+        check.expect(i, c.inputs.size(), "converged", c.inputs[0], limiter.getEMA());
+    }
+    return check.report();
+}
+#endif
+
+template <typename T> T toSample(int value) { return (T)value; }
+template <> SRL_Q15 toSample<SRL_Q15>(int value) { return SRL_Q15::fromRaw((int16_t)value); }
+template <typename T> int fromSample(T value) { return (int)value; }
+int fromSample(SRL_Q15 value) { return value.raw; }
+
+template <typename T>
+bool fitsSample(const Case& c)
+{
+    const long long lo = (sizeof(T) >= sizeof(long long)) ? -(1LL << 62) : -(1LL << (8 * sizeof(T) - 1));
+    const long long hi = -lo - 1;
+    if (c.rate < lo || c.rate > hi || c.band < lo || c.band > hi)
+    {
+        return false;
+    }
+    for (size_t s = 0; s < c.inputs.size(); s++)
+    {
+        if (c.inputs[s] < lo || c.inputs[s] > hi)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool checkBasic(const std::vector<Case>& cases, const char* name)
+{
+    Checker check(name);
+    for (size_t i = 0; i < cases.size(); i++)
+    {
+        const Case& c = cases[i];
+        if (!fitsSample<T>(c))
+        {
+            continue;
+        }
+        BasicSlewRateLimiter<T> limiter((SlewRateLimiter::SRL_SmoothingExponent)c.exponent, c.rate, c.band, c.slope,
+                                        (SlewRateLimiter::SRL_EMAMode)c.mode);
+        for (size_t s = 0; s < c.inputs.size(); s++)
+        {
+            check.expect(i, s, "output", c.outputs[s], fromSample(limiter.processValue(toSample<T>(c.inputs[s]))));
+            check.expect(i, s, "ema", c.ema[s], fromSample(limiter.getEMA()));
+        }
+    }
+    return check.report();
+}
+
+// The floating-point limiters against the double model, within tolerance times the largest input magnitude of the
+// case (rounding errors scale with the inputs, not with the EMA, which can cancel to near zero). Where the output is
+// integer (no adaptive slope, and the EMA does not drive), it must also match the corpus exactly.
+template <typename T>
+bool checkFloat(const std::vector<Case>& cases, const char* name, double tolerance)
+{
+    Checker check(name);
+    for (size_t i = 0; i < cases.size(); i++)
+    {
+        const Case& c = cases[i];
+        SRL_FloatReferenceLimiter reference;
+        reference.configure(c.exponent, c.rate, c.band, c.slope, c.mode);
+        BasicSlewRateLimiter<T> limiter((SlewRateLimiter::SRL_SmoothingExponent)c.exponent, (T)c.rate, (T)c.band,
+                                        c.slope, (SlewRateLimiter::SRL_EMAMode)c.mode);
+        bool integerOutput = c.slope == 0 && c.mode != SlewRateLimiter::SRL_EMA_DRIVE;
+        double scale = 1;
+        for (size_t s = 0; s < c.inputs.size(); s++)
+        {
+            scale = std::max(scale, std::fabs((double)c.inputs[s]));
+        }
+        for (size_t s = 0; s < c.inputs.size(); s++)
+        {
+            double expected = reference.process(c.inputs[s]);
+            double actual = limiter.processValue((T)c.inputs[s]);
+            double ema = limiter.getEMA();
+            check.expect(i, s, "output", 1, std::fabs(actual - expected) <= tolerance * scale);
+            check.expect(i, s, "ema", 1, std::fabs(ema - reference.emaValue) <= tolerance * scale);
+            if (integerOutput)
+            {
+                check.expect(i, s, "integer output", c.outputs[s], (int)actual);
+            }
+        }
+    }
+    return check.report();
+}
+
+bool checkFractional(const std::vector<Case>& cases)
+{
+    Checker check("FractionalSlewRateLimiter");
+    for (size_t i = 0; i < cases.size(); i++)
+    {
+        const Case& c = cases[i];
+        if (!fitsSample<int16_t>(c))
+        {
+            continue;
+        }
+        FractionalSlewRateLimiter limiter((SlewRateLimiter::SRL_SmoothingExponent)c.exponent, c.rate, c.band, c.slope,
+                                          (SlewRateLimiter::SRL_EMAMode)c.mode);
+        for (size_t s = 0; s < c.inputs.size(); s++)
+        {
+            check.expect(i, s, "output", c.outputs[s], limiter.processValue(c.inputs[s]));
+            check.expect(i, s, "ema", c.ema[s], limiter.getEMA());
+        }
+    }
+
+    // 3/40 of a unit per sample, up and down: the exact Q16.16 position is floor(3 * 65536 / 40) * n
+    for (int direction = -1; direction <= 1; direction += 2)
+    {
+        FractionalSlewRateLimiter limiter(SlewRateLimiter::SRL_SMOOTHING_4, 0, 0, 0, SlewRateLimiter::SRL_EMA_OFF);
+        limiter.setRateLimitFraction(3, 40);
+        limiter.processValue(0);
+        long step = 3 * 65536L / 40;
+        for (long n = 1; n <= 4000; n++)
+        {
+            limiter.processValue(direction * 1000);
+            long expected = direction * step * n;
+            check.expect(cases.size(), (size_t)n, "fraction", (int)((expected + 0x8000) >> 16),
+                         (int)((limiter.getValueQ16() + 0x8000) >> 16));
+            check.expect(cases.size(), (size_t)n, "fraction q16", (int)expected, (int)limiter.getValueQ16());
+        }
+    }
+
+    // Denominators above 65536 overflow remainder * 65536 in 32 bits (the AVR width of unsigned long)
+    const long fractions[][2] = {
+        { 70000, 100000 }, { 1, 65537 }, { 65536, 65537 }, { 99999, 100000 }, { 123456789, 1000000 },
+        { 1000, 2147483647 }, { 2147483646, 2147483647 }, { 2147483647, 1 }, { 3, 40 }, { 65535, 1 }
+    };
+    FractionalSlewRateLimiter rates;
+    for (size_t f = 0; f < sizeof(fractions) / sizeof(fractions[0]); f++)
+    {
+        uint64_t numerator = (uint64_t)fractions[f][0];
+        uint64_t denominator = (uint64_t)fractions[f][1];
+        uint64_t whole = numerator / denominator;
+        uint64_t expected = (whole > 0xFFFF) ? 0xFFFF0000ULL : (whole << 16) + ((numerator % denominator) << 16) / denominator;
+        rates.setRateLimitFraction(fractions[f][0], fractions[f][1]);
+        check.expect(cases.size() + 1, f, "rate fraction", (int)expected, (int)rates.getRateLimitQ16());
+    }
+    return check.report();
+}
+
+template <SlewRateLimiter::SRL_SmoothingExponent Exponent, SlewRateLimiter::SRL_EMAMode Mode>
+void runStatic(const Case& c, std::vector<int>& outputs, std::vector<int>& ema)
+{
+    StaticSlewRateLimiter<Exponent, true, true, Mode> limiter(c.rate, c.band, c.slope);
+    for (size_t s = 0; s < c.inputs.size(); s++)
+    {
+        outputs[s] = limiter.processValue(c.inputs[s]);
+        ema[s] = limiter.getEMA();
+    }
+}
+
+template <SlewRateLimiter::SRL_EMAMode Mode>
+void runStaticExponent(const Case& c, std::vector<int>& outputs, std::vector<int>& ema)
+{
+    switch (c.exponent)
+    {
+        case 0: runStatic<SlewRateLimiter::SRL_SMOOTHING_1, Mode>(c, outputs, ema); break;
+        case 1: runStatic<SlewRateLimiter::SRL_SMOOTHING_2, Mode>(c, outputs, ema); break;
+        case 2: runStatic<SlewRateLimiter::SRL_SMOOTHING_4, Mode>(c, outputs, ema); break;
+        case 3: runStatic<SlewRateLimiter::SRL_SMOOTHING_8, Mode>(c, outputs, ema); break;
+        case 4: runStatic<SlewRateLimiter::SRL_SMOOTHING_16, Mode>(c, outputs, ema); break;
+        case 5: runStatic<SlewRateLimiter::SRL_SMOOTHING_32, Mode>(c, outputs, ema); break;
+        case 6: runStatic<SlewRateLimiter::SRL_SMOOTHING_64, Mode>(c, outputs, ema); break;
+        case 7: runStatic<SlewRateLimiter::SRL_SMOOTHING_128, Mode>(c, outputs, ema); break;
+        case 8: runStatic<SlewRateLimiter::SRL_SMOOTHING_256, Mode>(c, outputs, ema); break;
+        default: runStatic<SlewRateLimiter::SRL_SMOOTHING_512, Mode>(c, outputs, ema); break;
+    }
+}
+
+bool checkStatic(const std::vector<Case>& cases)
+{
+    Checker check("StaticSlewRateLimiter");
+    for (size_t i = 0; i < cases.size(); i++)
+    {
+        const Case& c = cases[i];
+        std::vector<int> outputs(c.inputs.size());
+        std::vector<int> ema(c.inputs.size());
+        switch (c.mode)
+        {
+            case SlewRateLimiter::SRL_EMA_OFF: runStaticExponent<SlewRateLimiter::SRL_EMA_OFF>(c, outputs, ema); break;
+            case SlewRateLimiter::SRL_EMA_DRIVE: runStaticExponent<SlewRateLimiter::SRL_EMA_DRIVE>(c, outputs, ema); break;
+            default: runStaticExponent<SlewRateLimiter::SRL_EMA_TRACK>(c, outputs, ema); break;
+        }
+        for (size_t s = 0; s < c.inputs.size(); s++)
+        {
+            check.expect(i, s, "output", c.outputs[s], outputs[s]);
+            check.expect(i, s, "ema", c.ema[s], ema[s]);
+        }
+    }
+    return check.report();
+}
+
+bool checkBank(const std::vector<Case>& cases, SRL_Kernel kernel)
+{
+    Checker check(std::string("bank-") + SRL_kernelName(kernel));
+    size_t samples = cases[0].inputs.size();
+
+    for (int mode = SlewRateLimiter::SRL_EMA_TRACK; mode <= SlewRateLimiter::SRL_EMA_DRIVE; mode++)
+    {
+        std::vector<size_t> members;
+        for (size_t i = 0; i < cases.size(); i++)
+        {
+            if (cases[i].mode == mode && cases[i].inputs.size() == samples)
+            {
+                members.push_back(i);
+            }
+        }
+        if (members.empty())
+        {
+            continue;
+        }
+
+        SlewRateLimiterBank bank(members.size(), SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0,
+                                 (SlewRateLimiter::SRL_EMAMode)mode);
+        for (size_t m = 0; m < members.size(); m++)
+        {
+            const Case& c = cases[members[m]];
+            bank.setSmoothingExponent(m, (SlewRateLimiter::SRL_SmoothingExponent)c.exponent);
+            bank.setRateLimit(m, c.rate);
+            bank.setHysteresisBand(m, c.band);
+            bank.setAdaptiveSlope(m, c.slope);
+        }
+
+        std::vector<int> inputs(members.size());
+        std::vector<int> outputs(members.size());
+        for (size_t s = 0; s < samples; s++)
+        {
+            for (size_t m = 0; m < members.size(); m++)
+            {
+                inputs[m] = cases[members[m]].inputs[s];
+            }
+            bank.processAll(&inputs[0], &outputs[0]);
+            for (size_t m = 0; m < members.size(); m++)
+            {
+                const Case& c = cases[members[m]];
+                check.expect(members[m], s, "output", c.outputs[s], outputs[m]);
+                check.expect(members[m], s, "ema", c.ema[s], bank.getEMA(m));
+            }
+        }
+    }
+    return check.report();
+}
+
+bool checkBank16(const std::vector<Case>& cases, SRL_Kernel kernel)
+{
+    Checker check(std::string("bank16-") + SRL_kernelName(kernel));
+    size_t samples = cases[0].inputs.size();
+    const size_t copies = 4;
+
+    for (int mode = SlewRateLimiter::SRL_EMA_TRACK; mode <= SlewRateLimiter::SRL_EMA_DRIVE; mode++)
+    {
+        std::vector<size_t> members;
+        for (size_t copy = 0; copy < copies; copy++)
+        {
+            for (size_t i = 0; i < cases.size(); i++)
+            {
+                if (cases[i].mode == mode && cases[i].inputs.size() == samples && fitsSample<int16_t>(cases[i]))
+                {
+                    members.push_back(i);
+                }
+            }
+        }
+        if (members.empty())
+        {
+            continue;
+        }
+
+        SlewRateLimiterBank16 bank(members.size(), SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0,
+                                   (SlewRateLimiter::SRL_EMAMode)mode);
+        for (size_t m = 0; m < members.size(); m++)
+        {
+            const Case& c = cases[members[m]];
+            bank.setSmoothingExponent(m, (SlewRateLimiter::SRL_SmoothingExponent)c.exponent);
+            bank.setRateLimit(m, (int16_t)c.rate);
+            bank.setHysteresisBand(m, (int16_t)c.band);
+            bank.setAdaptiveSlope(m, c.slope);
+        }
+
+        std::vector<int16_t> inputs(members.size());
+        std::vector<int16_t> outputs(members.size());
+        for (size_t s = 0; s < samples; s++)
+        {
+            for (size_t m = 0; m < members.size(); m++)
+            {
+                inputs[m] = (int16_t)cases[members[m]].inputs[s];
+            }
+            bank.processAll(&inputs[0], &outputs[0]);
+            for (size_t m = 0; m < members.size(); m++)
+            {
+                const Case& c = cases[members[m]];
+                check.expect(members[m], s, "output", c.outputs[s], outputs[m]);
+                check.expect(members[m], s, "ema", c.ema[s], bank.getEMA(m));
+            }
+        }
+    }
+    return check.report();
+}
+
+bool checkGroup(const std::vector<Case>& cases)
+{
+    Checker check("group");
+    const size_t channels = 5;
+    for (size_t i = 0; i < cases.size(); i++)
+    {
+        const Case& c = cases[i];
+        SRL_Config config((SlewRateLimiter::SRL_SmoothingExponent)c.exponent, c.rate, c.band, c.slope,
+                          (SlewRateLimiter::SRL_EMAMode)c.mode);
+
+        // Two groups share the configuration: one runs processAll, the other processValue per channel
+        SlewRateLimiterGroup all(config, channels);
+        SlewRateLimiterGroup single(config, channels);
+        std::vector<int> inputs(channels);
+        std::vector<int> outputs(channels);
+        for (size_t s = 0; s < c.inputs.size(); s++)
+        {
+            for (size_t ch = 0; ch < channels; ch++)
+            {
+                inputs[ch] = c.inputs[s];
+            }
+            all.processAll(&inputs[0], &outputs[0]);
+            for (size_t ch = 0; ch < channels; ch++)
+            {
+                check.expect(i, s, "output", c.outputs[s], outputs[ch]);
+                check.expect(i, s, "ema", c.ema[s], all.getEMA(ch));
+            }
+            size_t ch = s % channels;
+            check.expect(i, s, "processValue", c.outputs[s], single.processValue(ch, c.inputs[s]));
+            for (size_t other = 0; other < channels; other++)
+            {
+                if (other != ch)
+                {
+                    single.processValue(other, c.inputs[s]);
+                }
+            }
+            check.expect(i, s, "getValue", c.outputs[s], single.getValue(ch));
+        }
+    }
+    return check.report();
+}
+
+bool checkScheduler(const std::vector<Case>& cases)
+{
+    Checker check("scheduler");
+    unsigned state = 23;
+    size_t samples = cases[0].inputs.size();
+
+    for (int mode = SlewRateLimiter::SRL_EMA_TRACK; mode <= SlewRateLimiter::SRL_EMA_DRIVE; mode++)
+    {
+        std::vector<size_t> members;
+        for (size_t i = 0; i < cases.size(); i++)
+        {
+            if (cases[i].mode == mode && cases[i].inputs.size() == samples)
+            {
+                members.push_back(i);
+            }
+        }
+        if (members.empty())
+        {
+            continue;
+        }
+
+        SlewRateLimiterScheduler scheduler(members.size(), SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0,
+                                           (SlewRateLimiter::SRL_EMAMode)mode);
+        std::vector<SlewRateLimiter> reference;
+        std::vector<int> targets(members.size(), 0);
+        for (size_t m = 0; m < members.size(); m++)
+        {
+            const Case& c = cases[members[m]];
+            scheduler.setSmoothingExponent(m, (SlewRateLimiter::SRL_SmoothingExponent)c.exponent);
+            scheduler.setRateLimit(m, c.rate);
+            scheduler.setHysteresisBand(m, c.band);
+            scheduler.setAdaptiveSlope(m, c.slope);
+            reference.push_back(makeLimiter(c));
+        }
+
+        for (size_t s = 0; s < samples; s++)
+        {
+            // Channels change targets at different times, and each starts at its own offset into its case
+            for (size_t m = 0; m < members.size(); m++)
+            {
+                if (nextRandom(state) % 4 != 0)
+                {
+                    targets[m] = cases[members[m]].inputs[(s + m) % samples];
+                    scheduler.setTarget(m, targets[m]);
+                }
+            }
+
+            // Mostly short holds; a few past 65536 ticks, so channels go through level 2 of the wheel
+            unsigned long n = 1 + nextRandom(state) % 8;
+            n = (s % 97 == 3) ? 70000 + nextRandom(state) % 1000 : n;
+            for (unsigned long k = 0; k < n; k++)
+            {
+                size_t settled = scheduler.tick();
+                for (size_t m = 0; m < members.size(); m++)
+                {
+                    reference[m].processValue(targets[m]);
+                }
+                for (size_t e = 0; e < settled; e++)
+                {
+                    size_t m = scheduler.settledChannel(e);
+                    check.expect(members[m], s, "settled", 1, reference[m].isSettled());
+                }
+                size_t probe = nextRandom(state) % members.size();
+                check.expect(members[probe], s, "read", reference[probe].advance(targets[probe], 0),
+                             scheduler.getValue(probe));
+            }
+
+            for (size_t m = 0; m < members.size(); m++)
+            {
+                check.expect(members[m], s, "output", reference[m].advance(targets[m], 0), scheduler.getValue(m));
+                check.expect(members[m], s, "ema", reference[m].getEMA(), scheduler.getEMA(m));
+                unsigned long ticks = reference[m].ticksToSettle(targets[m]);
+                check.expect(members[m], s, "scheduled", ticks != 0 && ticks != SRL_NEVER_SETTLES,
+                             scheduler.isScheduled(m));
+            }
+        }
+    }
+
+    // Unit-rate ramps long enough for every level of the wheel: each channel must settle exactly
+    // |target| ticks after its target was set, and read back as a straight ramp on the way
+    static const int far[] = { 200, -300, 70000, -150000, 17000000 };
+    const size_t count = sizeof(far) / sizeof(far[0]);
+    SlewRateLimiterScheduler scheduler(count, SlewRateLimiter::SRL_SMOOTHING_4, 1, 0, 0,
+                                       SlewRateLimiter::SRL_EMA_OFF);
+    scheduler.tick();
+    for (size_t m = 0; m < count; m++)
+    {
+        scheduler.setTarget(m, far[m]);
+    }
+    uint32_t start = scheduler.now();
+    std::vector<unsigned long> settledAt(count, 0);
+    for (unsigned long k = 1; k <= 17000001UL; k++)
+    {
+        size_t settled = scheduler.tick();
+        for (size_t e = 0; e < settled; e++)
+        {
+            settledAt[scheduler.settledChannel(e)] = k;
+        }
+        if (k % 65521 == 0)
+        {
+            size_t m = nextRandom(state) % count;
+            long distance = std::labs((long)far[m]);
+            long expected = (long)k < distance ? (far[m] < 0 ? -(long)k : (long)k) : far[m];
+            check.expect(cases.size(), k, "ramp", (int)expected, scheduler.getValue(m));
+        }
+    }
+    for (size_t m = 0; m < count; m++)
+    {
+        check.expect(cases.size(), m, "settle tick", std::abs(far[m]), (int)settledAt[m]);
+        check.expect(cases.size(), m, "final", far[m], scheduler.getValue(m));
+    }
+    check.expect(cases.size(), count, "now", (int)(start + 17000001UL), (int)scheduler.now());
+    return check.report();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc == 3 && std::strcmp(argv[1], "--generate") == 0)
+    {
+        return writeCorpus(argv[2], generateCases()) ? 0 : 1;
+    }
+    if (argc > 2)
+    {
+        std::fprintf(stderr, "usage: %s [corpus] | --generate <corpus>\n", argv[0]);
+        return 2;
+    }
+
+    const char* path = (argc == 2) ? argv[1] : SRL_CONFORMANCE_CORPUS;
+    std::vector<Case> cases;
+    if (!readCorpus(path, cases))
+    {
+        return 1;
+    }
+    std::printf("%zu cases from %s\n", cases.size(), path);
+
+#ifdef SRL_WIDE_EMA
+    bool ok = checkWideEMA<signed char>("SRL_WideEMA8");
+    ok = checkWideEMA<int16_t>("SRL_WideEMA16") && ok;
+    ok = checkWideEMA<int32_t>("SRL_WideEMA32") && ok;
+    ok = checkWideLimiter(cases) && ok;
+    ok = checkAdvance(cases) && ok;
+    ok = checkSettle(cases) && ok;
+    return ok ? 0 : 1;
+#else
+    bool ok = checkReference(cases);
+    ok = checkProcessValue(cases) && ok;
+    ok = checkProcessBlock(cases) && ok;
+    ok = checkAdvance(cases) && ok;
+    ok = checkSettle(cases) && ok;
+    ok = checkProcessValueAt(cases) && ok;
+    ok = checkState(cases) && ok;
+#ifdef SRL_HAVE_MAPPED_BANK
+    ok = checkMappedBank(cases) && ok;
+#endif
+    ok = checkLazy(cases) && ok;
+    ok = checkWideEMA<signed char>("SRL_WideEMA8") && ok;
+    ok = checkWideEMA<int16_t>("SRL_WideEMA16") && ok;
+    ok = checkWideEMA<int32_t>("SRL_WideEMA32") && ok;
+    ok = checkBasic<int32_t>(cases, "BasicSlewRateLimiter32") && ok;
+    ok = checkBasic<int64_t>(cases, "BasicSlewRateLimiter64") && ok;
+    ok = checkBasic<int16_t>(cases, "BasicSlewRateLimiter16") && ok;
+    ok = checkBasic<SRL_Q15>(cases, "BasicSlewRateLimiterQ15") && ok;
+    std::vector<Case> cases8 = generateRangeCases(-128, 127, 8);
+    std::vector<Case> cases16 = generateRangeCases(-32768, 32767, 16);
+    ok = checkBasic<int8_t>(cases8, "BasicSlewRateLimiter8/full") && ok;
+    ok = checkBasic<int16_t>(cases16, "BasicSlewRateLimiter16/full") && ok;
+    ok = checkBasic<SRL_Q15>(cases16, "BasicSlewRateLimiterQ15/full") && ok;
+    ok = checkFloat<float>(cases, "BasicSlewRateLimiterFloat", 1e-5) && ok;
+    ok = checkFloat<double>(cases, "BasicSlewRateLimiterDouble", 1e-12) && ok;
+    ok = checkFractional(cases) && ok;
+    ok = checkStatic(cases) && ok;
+    for (int k = SRL_KERNEL_SCALAR; k <= SRL_KERNEL_AVX512; k++)
+    {
+        if (SRL_forceKernel((SRL_Kernel)k))
+        {
+            ok = checkBank(cases, (SRL_Kernel)k) && ok;
+            ok = checkBank16(cases, (SRL_Kernel)k) && ok;
+        }
+    }
+    SRL_forceKernel(SRL_KERNEL_AUTO);
+    ok = checkGroup(cases) && ok;
+    ok = checkScheduler(cases) && ok;
+
+    return ok ? 0 : 1;
+#endif
+}
@@ -0,0 +1,219 @@
+/**
+ * @file srl_reference.h
+ * @brief Bit-exact reference model of SlewRateLimiter::processValue.
+ *
+ * This is a deliberately plain transcription of the limiter, written for clarity rather than speed, that
+ * every kernel is checked against. All arithmetic is done on 32-bit two's complement values with explicit
+ * wrapping and floor (arithmetic) right shifts, so the model is well defined for every input, including the
+ * ones where the library's own int arithmetic overflows:
+ *
+ * - EMA: ((x << e) + (ema << 10) - (ema << e)) >> 10, i.e. the truncating shift of updateEMA.
+ * - Adaptive slope: (slope * 128 + 50) / 100 with C++ truncating division, as in setAdaptiveSlope, then
+ *   allowedChange = rate + ((|delta| * slopeInternal) >> 7).
+ * - Rate limiting: the if / else-if / else chain of processValue, in that order.
+ * - Hysteresis: |target - last| <= band snaps the output to the target.
+ * - EMA modes: track (EMA updated, unused), off (EMA not updated) and drive (the EMA is the target).
+ *
+ * SRL_WideReferenceLimiter is the same model with the EMA of an SRL_WIDE_EMA build (SlewRateLimiterEMA.h): a
+ * 64-bit accumulator with 10 fractional bits, acc += (x << e) - (acc >> (10 - e)), read as acc >> 10.
+ *
+ * SRL_FloatReferenceLimiter is the floating-point limiter of BasicSlewRateLimiter<float/double>, in double: the
+ * EMA weight is 2^e / 1024 and the adaptive slope adds |delta| * slope / 100, with no truncation.
+ */
+
+#ifndef srl_reference_h
+#define srl_reference_h
+
+#include <stdint.h>
+
+struct SRL_ReferenceLimiter
+{
+    int32_t lastValue;
+    int32_t emaValue;
+    bool isFirstCall;
+    int exponent;
+    int32_t rateLimit;
+    int32_t hysteresisBand;
+    int32_t adaptiveSlopeInternal;
+    int emaMode;   // 0 = track, 1 = off, 2 = drive, as SlewRateLimiter::SRL_EMAMode
+
+    static int32_t add(int32_t a, int32_t b) { return (int32_t)((uint32_t)a + (uint32_t)b); }
+    static int32_t sub(int32_t a, int32_t b) { return (int32_t)((uint32_t)a - (uint32_t)b); }
+    static int32_t mul(int32_t a, int32_t b) { return (int32_t)((uint32_t)a * (uint32_t)b); }
+    static int32_t shl(int32_t a, int n) { return (int32_t)((uint32_t)a << n); }
+    static int32_t sar(int32_t a, int n) { return a < 0 ? ~(~a >> n) : a >> n; }
+    static int32_t absWrap(int32_t a) { return a < 0 ? sub(0, a) : a; }
+
+    static int32_t slopeToInternal(int32_t slope)
+    {
+        return (slope * 128 + 50) / 100;
+    }
+
+    void configure(int smoothingExponent, int32_t rate, int32_t band, int32_t slope, int mode)
+    {
+        lastValue = 0;
+        emaValue = 0;
+        isFirstCall = true;
+        exponent = smoothingExponent;
+        rateLimit = rate;
+        hysteresisBand = band;
+        adaptiveSlopeInternal = slopeToInternal(slope);
+        emaMode = mode;
+    }
+
+    int32_t process(int32_t x)
+    {
+        if (isFirstCall)
+        {
+            lastValue = x;
+            emaValue = x;
+            isFirstCall = false;
+            return x;
+        }
+
+        int32_t target = x;
+        if (emaMode != 1)
+        {
+            emaValue = sar(sub(add(shl(x, exponent), shl(emaValue, 10)), shl(emaValue, exponent)), 10);
+            if (emaMode == 2)
+            {
+                target = emaValue;
+            }
+        }
+        return limit(target);
+    }
+
+    // Rate limiting and hysteresis of one target, shared with SRL_WideReferenceLimiter
+    int32_t limit(int32_t target)
+    {
+        int32_t delta = sub(target, lastValue);
+        int32_t allowedChange = add(rateLimit, sar(mul(absWrap(delta), adaptiveSlopeInternal), 7));
+
+        if (delta > allowedChange)
+        {
+            lastValue = add(lastValue, allowedChange);
+        }
+        else if (delta < sub(0, allowedChange))
+        {
+            lastValue = sub(lastValue, allowedChange);
+        }
+        else
+        {
+            lastValue = target;
+        }
+
+        if (absWrap(sub(target, lastValue)) <= hysteresisBand)
+        {
+            lastValue = target;
+        }
+
+        return lastValue;
+    }
+};
+
+struct SRL_WideReferenceLimiter : SRL_ReferenceLimiter
+{
+    int64_t emaAccumulator;
+
+    static int64_t sar64(int64_t a, int n) { return a < 0 ? ~(~a >> n) : a >> n; }
+
+    void configure(int smoothingExponent, int32_t rate, int32_t band, int32_t slope, int mode)
+    {
+        SRL_ReferenceLimiter::configure(smoothingExponent, rate, band, slope, mode);
+        emaAccumulator = 0;
+    }
+
+    int32_t process(int32_t x)
+    {
+        if (isFirstCall)
+        {
+            lastValue = x;
+            emaValue = x;
+            emaAccumulator = (int64_t)x * 1024;
+            isFirstCall = false;
+            return x;
+        }
+
+        int32_t target = x;
+        if (emaMode != 1)
+        {
+            emaAccumulator = emaAccumulator + (int64_t)x * ((int64_t)1 << exponent) - sar64(emaAccumulator, 10 - exponent);
+            emaValue = (int32_t)sar64(emaAccumulator, 10);
+            if (emaMode == 2)
+            {
+                target = emaValue;
+            }
+        }
+        return limit(target);
+    }
+};
+
+struct SRL_FloatReferenceLimiter
+{
+    double lastValue;
+    double emaValue;
+    bool isFirstCall;
+    int exponent;
+    double rateLimit;
+    double hysteresisBand;
+    double adaptiveSlope;
+    int emaMode;
+
+    void configure(int smoothingExponent, double rate, double band, int slope, int mode)
+    {
+        lastValue = 0;
+        emaValue = 0;
+        isFirstCall = true;
+        exponent = smoothingExponent;
+        rateLimit = rate;
+        hysteresisBand = band;
+        adaptiveSlope = slope / 100.0;
+        emaMode = mode;
+    }
+
+    double process(double x)
+    {
+        if (isFirstCall)
+        {
+            lastValue = x;
+            emaValue = x;
+            isFirstCall = false;
+            return x;
+        }
+
+        double target = x;
+        if (emaMode != 1)
+        {
+            emaValue += (x - emaValue) * ((1 << exponent) / 1024.0);
+            if (emaMode == 2)
+            {
+                target = emaValue;
+            }
+        }
+
+        double delta = target - lastValue;
+        double absDelta = delta < 0 ? -delta : delta;
+        double allowedChange = rateLimit + absDelta * adaptiveSlope;
+        if (delta > allowedChange)
+        {
+            lastValue += allowedChange;
+        }
+        else if (delta < -allowedChange)
+        {
+            lastValue -= allowedChange;
+        }
+        else
+        {
+            lastValue = target;
+        }
+
+        double remaining = target - lastValue;
+        if ((remaining < 0 ? -remaining : remaining) <= hysteresisBand)
+        {
+            lastValue = target;
+        }
+        return lastValue;
+    }
+};
+
+#endif /* srl_reference_h */
@@ -0,0 +1,60 @@
+/**
+ * @file BlockBenchmark.ino
+ * @brief Compares the throughput of processBlock against a per-sample processValue loop.
+ *
+ * Both limiters are fed the same noisy ramp, the outputs are checked for bit-exactness and
+ * the time per buffer is printed to the serial port.
+ */
+
+#include "SlewRateLimiter.h"
+
+const size_t BLOCK_SIZE = 256;
+const int ITERATIONS = 100;
+
+int inputBuffer[BLOCK_SIZE];
+int sampleOutput[BLOCK_SIZE];
+int blockOutput[BLOCK_SIZE];
+
+SlewRateLimiter sampleLimiter(SlewRateLimiter::SRL_SMOOTHING_16, 10, 3, 50);
+SlewRateLimiter blockLimiter(SlewRateLimiter::SRL_SMOOTHING_16, 10, 3, 50);
+
+void setup() {
+  Serial.begin(115200);
+
+  for (size_t i = 0; i < BLOCK_SIZE; i++) {
+    inputBuffer[i] = (int)(i * 4) + random(-20, 20);
+  }
+
+  unsigned long start = micros();
+  for (int n = 0; n < ITERATIONS; n++) {
+    for (size_t i = 0; i < BLOCK_SIZE; i++) {
+      sampleOutput[i] = sampleLimiter.processValue(inputBuffer[i]);
+    }
+  }
+  unsigned long sampleTime = micros() - start;
+
+  start = micros();
+  for (int n = 0; n < ITERATIONS; n++) {
+    blockLimiter.processBlock(inputBuffer, blockOutput, BLOCK_SIZE);
+  }
+  unsigned long blockTime = micros() - start;
+
+  bool match = true;
+  for (size_t i = 0; i < BLOCK_SIZE; i++) {
+    if (sampleOutput[i] != blockOutput[i]) {
+      match = false;
+    }
+  }
+
+  Serial.print("processValue loop: ");
+  Serial.print(sampleTime / ITERATIONS);
+  Serial.println(" us per block");
+  Serial.print("processBlock:      ");
+  Serial.print(blockTime / ITERATIONS);
+  Serial.println(" us per block");
+  Serial.print("Bit-exact: ");
+  Serial.println(match ? "yes" : "NO");
+}
+
+void loop() {
+}
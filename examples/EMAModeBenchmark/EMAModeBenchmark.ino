@@ -0,0 +1,47 @@
+/**
+ * @file EMAModeBenchmark.ino
+ * @brief Measures the per-sample cost of processValue in each EMA mode.
+ *
+ * SRL_EMA_TRACK is the historical behaviour (the EMA is updated but unused), SRL_EMA_OFF skips the EMA
+ * entirely and SRL_EMA_DRIVE rate limits the smoothed signal instead of the raw input.
+ */
+
+#include "SlewRateLimiter.h"
+
+const int SAMPLES = 2000;
+
+int inputBuffer[64];
+
+unsigned long timeMode(SlewRateLimiter::SRL_EMAMode mode) {
+  SlewRateLimiter limiter(SlewRateLimiter::SRL_SMOOTHING_16, 10, 3, 0, mode);
+  volatile int sink = 0;
+
+  unsigned long start = micros();
+  for (int i = 0; i < SAMPLES; i++) {
+    sink = limiter.processValue(inputBuffer[i & 63]);
+  }
+  (void)sink;
+  return micros() - start;
+}
+
+void printResult(const char* name, unsigned long elapsed) {
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print((float)elapsed * 1000.0 / SAMPLES);
+  Serial.println(" ns per sample");
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  for (int i = 0; i < 64; i++) {
+    inputBuffer[i] = 500 + random(-100, 100);
+  }
+
+  printResult("SRL_EMA_TRACK", timeMode(SlewRateLimiter::SRL_EMA_TRACK));
+  printResult("SRL_EMA_OFF  ", timeMode(SlewRateLimiter::SRL_EMA_OFF));
+  printResult("SRL_EMA_DRIVE", timeMode(SlewRateLimiter::SRL_EMA_DRIVE));
+}
+
+void loop() {
+}
@@ -0,0 +1,50 @@
+/**
+ * @file InlineBenchmark.ino
+ * @brief Prints the cycles per sample of processValue in the current build configuration.
+ *
+ * SRL_HEADER_ONLY must be set for the whole build (the sketch and the library together), so the two
+ * configurations are compared by building and running this sketch twice:
+ * - Default build: processValue is a call into the compiled library.
+ * - Header-only build: add -DSRL_HEADER_ONLY to the build flags, e.g.
+ *   arduino-cli compile --build-property "compiler.cpp.extra_flags=-DSRL_HEADER_ONLY" ...
+ *   processValue is then inlined into the loop below.
+ * The difference between the two results is the per-call overhead the header-only build removes.
+ */
+
+#include "SlewRateLimiter.h"
+
+const int SAMPLES = 2000;
+
+int inputBuffer[64];
+
+unsigned long runLimiter(const int* inputs, int samples) {
+  SlewRateLimiter limiter(SlewRateLimiter::SRL_SMOOTHING_16, 10, 3, 0);
+  volatile int sink = 0;
+
+  unsigned long start = micros();
+  for (int i = 0; i < samples; i++) {
+    sink = limiter.processValue(inputs[i & 63]);
+  }
+  (void)sink;
+  return micros() - start;
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  for (int i = 0; i < 64; i++) {
+    inputBuffer[i] = 500 + random(-100, 100);
+  }
+
+  unsigned long elapsed = runLimiter(inputBuffer, SAMPLES);
+#ifdef SRL_HEADER_ONLY
+  Serial.print("Header-only build: ");
+#else
+  Serial.print("Library build: ");
+#endif
+  Serial.print((float)elapsed * (F_CPU / 1000000UL) / SAMPLES);
+  Serial.println(" cycles per sample");
+}
+
+void loop() {
+}
@@ -0,0 +1,87 @@
+/**
+ * @file WideEMABenchmark.ino
+ * @brief Compares the cycle cost of three EMA updates on full-range ADC data.
+ *
+ * - int:  the classic EMA in int arithmetic. Fast, but on AVR (16-bit int) it overflows for these inputs.
+ * - long: the usual workaround, the same formula with every operation promoted to long.
+ * - wide: SRL_WideEMA<int>, a long accumulator with 10 fractional bits and an int output, as used by
+ *         SlewRateLimiter when SRL_WIDE_EMA is defined.
+ *
+ * Each variant is also checked against a step to 30000: the final value shows overflow (int) and the
+ * truncation bias (long settles below the input, wide reaches it).
+ */
+
+#include "SlewRateLimiterEMA.h"
+
+const int SAMPLES = 2000;
+const int EXPONENT = 4;
+
+int inputBuffer[64];
+
+int emaInt(int newValue, int ema) {
+  return (newValue * (1 << EXPONENT) + ema * 1024 - ema * (1 << EXPONENT)) >> 10;
+}
+
+int emaLong(int newValue, int ema) {
+  return (int)(((long)newValue * (1 << EXPONENT) + (long)ema * 1024 - (long)ema * (1 << EXPONENT)) >> 10);
+}
+
+void printResult(const char* name, unsigned long elapsed, int settled) {
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print((float)elapsed * (F_CPU / 1000000UL) / SAMPLES);
+  Serial.print(" cycles per sample, step to 30000 settles at ");
+  Serial.println(settled);
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  for (int i = 0; i < 64; i++) {
+    inputBuffer[i] = 30000 + random(-2000, 2000);
+  }
+
+  volatile int sink;
+  unsigned long start;
+
+  int ema = 0;
+  start = micros();
+  for (int i = 0; i < SAMPLES; i++) {
+    ema = emaInt(inputBuffer[i & 63], ema);
+  }
+  sink = ema;
+  unsigned long intTime = micros() - start;
+
+  ema = 0;
+  start = micros();
+  for (int i = 0; i < SAMPLES; i++) {
+    ema = emaLong(inputBuffer[i & 63], ema);
+  }
+  sink = ema;
+  unsigned long longTime = micros() - start;
+
+  SRL_WideEMA<int>::Accumulator accumulator = SRL_WideEMA<int>::init(0);
+  start = micros();
+  for (int i = 0; i < SAMPLES; i++) {
+    accumulator = SRL_WideEMA<int>::update(inputBuffer[i & 63], accumulator, EXPONENT);
+  }
+  sink = SRL_WideEMA<int>::output(accumulator);
+  unsigned long wideTime = micros() - start;
+  (void)sink;
+
+  int intEma = 0;
+  int longEma = 0;
+  accumulator = SRL_WideEMA<int>::init(0);
+  for (int i = 0; i < 2000; i++) {
+    intEma = emaInt(30000, intEma);
+    longEma = emaLong(30000, longEma);
+    accumulator = SRL_WideEMA<int>::update(30000, accumulator, EXPONENT);
+  }
+
+  printResult("int ", intTime, intEma);
+  printResult("long", longTime, longEma);
+  printResult("wide", wideTime, SRL_WideEMA<int>::output(accumulator));
+}
+
+void loop() {
+}
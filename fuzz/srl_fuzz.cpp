@@ -0,0 +1,739 @@
+/**
+ * @file srl_fuzz.cpp
+ * @brief Differential fuzzer for SlewRateLimiter, every optimized kernel and every limiter class.
+ *
+ * The fuzz input is decoded into a stream of operations on CHANNELS independent channels: ticks with one new
+ * input per channel, setter calls and resets. Every operation is applied to
+ * - the reference model (conformance/srl_reference.h),
+ * - one SlewRateLimiter per channel driven with processValue,
+ * - one SlewRateLimiter per channel driven with processBlock (buffered between setter calls),
+ * - one SlewRateLimiterBank per kernel the CPU supports,
+ * - one SlewRateLimiterBank driven through its active set (setInput and tick),
+ * - one SlewRateLimiterBank16 per kernel the CPU supports (16-bit domain only, see below),
+ * - one single-channel SlewRateLimiterGroup per channel, rebuilt with a new SRL_Config on every setter call
+ *   and its state moved over, driven with processAll and processValue on alternate ticks,
+ * - one FractionalSlewRateLimiter per channel, with whole-unit rates (16-bit domain only),
+ * - one LazySlewRateLimiter per channel, written between ticks at a varying offset,
+ * - one single-channel SlewRateLimiterScheduler per channel, rebuilt on reset,
+ * - one StaticSlewRateLimiter per channel, instantiated for the channel's exponent and the EMA mode, and one
+ *   ConstSlewRateLimiter per channel with the default configuration; both are rebuilt on reset, and dropped
+ *   until then once a setter changes what they take as template parameters,
+ * and the outputs and EMA values of all of them must agree after every tick; any difference aborts. The lazy
+ * limiters and the schedulers are only written when a channel's input changes, and only read on ticks with
+ * new inputs (opcode 0), so they catch up over a hold in one go (closed-form advance, timing wheel).
+ * Build with -fsanitize=undefined (the CMake target does) so signed-overflow UB in the library is flagged too.
+ *
+ * By default inputs and bands are 16-bit values (full-range ADC data), rates are 0..32767 and slopes 0..1000 %,
+ * the domain in which the library's int arithmetic is defined on a 32-bit host. (A negative rate or slope
+ * makes allowedChange negative, and the output then runs away until it overflows.) Define SRL_FUZZ_FULL_RANGE
+ * to feed full 32-bit values and any rate or slope instead, and hunt for overflow.
+ *
+ * Input format (bytes are consumed in order, missing bytes read as zero):
+ *   byte 0            EMA mode (% 3)
+ *   then repeatedly   opcode % 4:
+ *     0  tick         CHANNELS input values
+ *     1  setter       channel, setter (% 4: rate, band, exponent, slope), value
+ *     2  reset        channel
+ *     3  hold         one input value for every channel, held for 1 + (byte % 16) ticks
+ *
+ * With libFuzzer (clang -fsanitize=fuzzer) LLVMFuzzerTestOneInput is the entry point. Otherwise (GCC, AFL)
+ * SRL_FUZZ_STANDALONE adds a main() that runs each file given on the command line, or random inputs with
+ * "--random <count>".
+ */
+
+#include "SlewRateLimiter.h"
+#include "SlewRateLimiterBank.h"
+#include "SlewRateLimiterBank16.h"
+#include "SlewRateLimiterGroup.h"
+#include "SlewRateLimiterScheduler.h"
+#include "SlewRateLimiterStatic.h"
+#include "FractionalSlewRateLimiter.h"
+#include "LazySlewRateLimiter.h"
+#include "SlewRateLimiterKernels.h"
+#include "../conformance/srl_reference.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+namespace {
+
+const size_t CHANNELS = 40;   // more than one 32-lane AVX-512BW vector, plus a scalar tail
+const size_t MAX_OPS = 4096;
+const uint32_t LAZY_PERIOD = 1000;                            // us per tick of the lazy limiters
+const uint32_t LAZY_START = 0xFFFFFFFFUL - 64 * LAZY_PERIOD;  // so the timestamps wrap around during a run
+
+struct Reader
+{
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+
+    bool done() const { return pos >= size; }
+
+    uint8_t byte()
+    {
+        return pos < size ? data[pos++] : 0;
+    }
+
+    int32_t value()
+    {
+#ifdef SRL_FUZZ_FULL_RANGE
+        uint32_t v = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            v |= (uint32_t)byte() << (8 * i);
+        }
+        return (int32_t)v;
+#else
+        uint16_t v = (uint16_t)(byte() | (byte() << 8));
+        return (int16_t)v;
+#endif
+    }
+};
+
+void fail(const char* what, size_t op, size_t channel, int expected, int actual)
+{
+    fprintf(stderr, "srl_fuzz: %s mismatch at op %zu channel %zu: expected %d, got %d\n",
+            what, op, channel, expected, actual);
+    abort();
+}
+
+// The compile-time limiters behind one interface, so the harness can hold one per channel whatever its
+// template arguments
+struct StaticChannel
+{
+    virtual ~StaticChannel() {}
+    virtual int processValue(int currentValue) = 0;
+    virtual int getEMA() const = 0;
+    virtual void configure(int rate, int band, int slope) = 0;
+};
+
+template <SlewRateLimiter::SRL_SmoothingExponent Exponent, SlewRateLimiter::SRL_EMAMode Mode>
+struct StaticChannelImpl : StaticChannel
+{
+    StaticSlewRateLimiter<Exponent, true, true, Mode> limiter;
+
+    StaticChannelImpl(int rate, int band, int slope) : limiter(rate, band, slope) {}
+    int processValue(int currentValue) { return limiter.processValue(currentValue); }
+    int getEMA() const { return limiter.getEMA(); }
+
+    void configure(int rate, int band, int slope)
+    {
+        limiter.setRateLimit(rate);
+        limiter.setHysteresisBand(band);
+        limiter.setAdaptiveSlope(slope);
+    }
+};
+
+// Instantiates StaticChannelImpl for a runtime exponent, by trying each exponent from E up
+template <int E, SlewRateLimiter::SRL_EMAMode Mode>
+struct StaticFactory
+{
+    static StaticChannel* make(int exponent, int rate, int band, int slope)
+    {
+        if (exponent == E)
+        {
+            return new StaticChannelImpl<(SlewRateLimiter::SRL_SmoothingExponent)E, Mode>(rate, band, slope);
+        }
+        return StaticFactory<E + 1, Mode>::make(exponent, rate, band, slope);
+    }
+};
+
+template <SlewRateLimiter::SRL_EMAMode Mode>
+struct StaticFactory<SlewRateLimiter::SRL_SMOOTHING_512 + 1, Mode>
+{
+    static StaticChannel* make(int, int, int, int) { return NULL; }
+};
+
+// ConstSlewRateLimiter with the default configuration of the harness channels
+template <SlewRateLimiter::SRL_EMAMode Mode>
+struct ConstChannelImpl : StaticChannel
+{
+    ConstSlewRateLimiter<SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0, Mode> limiter;
+
+    int processValue(int currentValue) { return limiter.processValue(currentValue); }
+    int getEMA() const { return limiter.getEMA(); }
+    void configure(int, int, int) {}
+};
+
+StaticChannel* makeStatic(SlewRateLimiter::SRL_EMAMode mode, int exponent, int rate, int band, int slope)
+{
+    switch (mode)
+    {
+        case SlewRateLimiter::SRL_EMA_OFF:
+            return StaticFactory<0, SlewRateLimiter::SRL_EMA_OFF>::make(exponent, rate, band, slope);
+        case SlewRateLimiter::SRL_EMA_DRIVE:
+            return StaticFactory<0, SlewRateLimiter::SRL_EMA_DRIVE>::make(exponent, rate, band, slope);
+        default:
+            return StaticFactory<0, SlewRateLimiter::SRL_EMA_TRACK>::make(exponent, rate, band, slope);
+    }
+}
+
+StaticChannel* makeConst(SlewRateLimiter::SRL_EMAMode mode)
+{
+    switch (mode)
+    {
+        case SlewRateLimiter::SRL_EMA_OFF:
+            return new ConstChannelImpl<SlewRateLimiter::SRL_EMA_OFF>();
+        case SlewRateLimiter::SRL_EMA_DRIVE:
+            return new ConstChannelImpl<SlewRateLimiter::SRL_EMA_DRIVE>();
+        default:
+            return new ConstChannelImpl<SlewRateLimiter::SRL_EMA_TRACK>();
+    }
+}
+
+struct Harness
+{
+    SlewRateLimiter::SRL_EMAMode mode;
+    std::vector<SRL_ReferenceLimiter> reference;
+    std::vector<SlewRateLimiter> single;
+    std::vector<SlewRateLimiter> block;
+    std::vector<SlewRateLimiterBank*> banks;
+    std::vector<SRL_Kernel> kernels;
+    SlewRateLimiterBank activeSet;
+#ifndef SRL_FUZZ_FULL_RANGE
+    std::vector<SlewRateLimiterBank16*> banks16;
+#endif
+    std::vector<SlewRateLimiterGroup*> groups;
+#ifndef SRL_FUZZ_FULL_RANGE
+    std::vector<FractionalSlewRateLimiter> fractional;
+#endif
+    std::vector<LazySlewRateLimiter> lazy;
+    uint32_t lazyClock;             // the timestamp of the next tick
+    std::vector<SlewRateLimiterScheduler*> schedulers;
+    std::vector<bool> fresh;        // whether the lazy limiter and the scheduler of a channel have no target yet
+    std::vector<int> targets;       // their targets
+    std::vector<StaticChannel*> statics;
+    std::vector<StaticChannel*> consts;
+    std::vector<int> slopes;        // the slopes in percent, which the constructors and setters take
+
+    // Inputs buffered for processBlock since the last flush, per channel, and the outputs they must produce
+    std::vector<std::vector<int> > pendingInputs;
+    std::vector<std::vector<int> > pendingOutputs;
+
+    explicit Harness(SlewRateLimiter::SRL_EMAMode emaMode)
+      : mode(emaMode),
+        reference(CHANNELS),
+        single(CHANNELS, SlewRateLimiter(SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0, emaMode)),
+        block(CHANNELS, SlewRateLimiter(SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0, emaMode)),
+        activeSet(CHANNELS, SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0, emaMode),
+        groups(CHANNELS),
+#ifndef SRL_FUZZ_FULL_RANGE
+        fractional(CHANNELS, FractionalSlewRateLimiter(SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0, emaMode)),
+#endif
+        lazy(CHANNELS, LazySlewRateLimiter(LAZY_PERIOD, SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0, emaMode)),
+        lazyClock(LAZY_START),
+        schedulers(CHANNELS),
+        fresh(CHANNELS, true),
+        targets(CHANNELS, 0),
+        statics(CHANNELS),
+        consts(CHANNELS),
+        slopes(CHANNELS, 0),
+        pendingInputs(CHANNELS),
+        pendingOutputs(CHANNELS)
+    {
+        for (size_t c = 0; c < CHANNELS; c++)
+        {
+            reference[c].configure(SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0, emaMode);
+            groups[c] = new SlewRateLimiterGroup(SRL_Config(SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0, emaMode), 1);
+            schedulers[c] = new SlewRateLimiterScheduler(1, SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0, emaMode);
+            statics[c] = makeStatic(emaMode, SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0);
+            consts[c] = makeConst(emaMode);
+        }
+        for (int k = SRL_KERNEL_SCALAR; k <= SRL_KERNEL_AVX512; k++)
+        {
+            if (SRL_forceKernel((SRL_Kernel)k))
+            {
+                kernels.push_back((SRL_Kernel)k);
+                banks.push_back(new SlewRateLimiterBank(CHANNELS, SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0, emaMode));
+#ifndef SRL_FUZZ_FULL_RANGE
+                banks16.push_back(new SlewRateLimiterBank16(CHANNELS, SlewRateLimiter::SRL_SMOOTHING_4, 5, 2, 0, emaMode));
+#endif
+            }
+        }
+        SRL_forceKernel(SRL_KERNEL_AUTO);
+    }
+
+    ~Harness()
+    {
+        for (size_t c = 0; c < CHANNELS; c++)
+        {
+            delete groups[c];
+            delete schedulers[c];
+            delete statics[c];
+            delete consts[c];
+        }
+        for (size_t b = 0; b < banks.size(); b++)
+        {
+            delete banks[b];
+#ifndef SRL_FUZZ_FULL_RANGE
+            delete banks16[b];
+#endif
+        }
+    }
+
+    // The configuration of a group is immutable: a setter builds a new group and moves the channel's state over
+    void rebuildGroup(size_t c)
+    {
+        SRL_State state;
+        groups[c]->getStates(&state);
+        delete groups[c];
+        SRL_Config config((SlewRateLimiter::SRL_SmoothingExponent)reference[c].exponent, reference[c].rateLimit,
+                          reference[c].hysteresisBand, slopes[c], mode);
+        groups[c] = new SlewRateLimiterGroup(config, 1);
+        groups[c]->setStates(&state);
+    }
+
+    void flushBlock(size_t op, size_t c)
+    {
+        std::vector<int>& inputs = pendingInputs[c];
+        if (inputs.empty())
+        {
+            return;
+        }
+        std::vector<int> outputs(inputs.size());
+        block[c].processBlock(&inputs[0], &outputs[0], inputs.size());
+        for (size_t i = 0; i < outputs.size(); i++)
+        {
+            if (outputs[i] != pendingOutputs[c][i])
+            {
+                fail("processBlock", op, c, pendingOutputs[c][i], outputs[i]);
+            }
+        }
+        if (block[c].getEMA() != single[c].getEMA())
+        {
+            fail("processBlock ema", op, c, single[c].getEMA(), block[c].getEMA());
+        }
+        inputs.clear();
+        pendingOutputs[c].clear();
+    }
+
+    // Each tick is one processValue call of the reference; read is false on hold ticks (see the file comment)
+    void tick(size_t op, const int* inputs, bool read)
+    {
+        std::vector<int> expected(CHANNELS);
+        for (size_t c = 0; c < CHANNELS; c++)
+        {
+            expected[c] = reference[c].process(inputs[c]);
+            int actual = single[c].processValue(inputs[c]);
+            if (actual != expected[c])
+            {
+                fail("processValue", op, c, expected[c], actual);
+            }
+            if (single[c].getEMA() != reference[c].emaValue)
+            {
+                fail("processValue ema", op, c, reference[c].emaValue, single[c].getEMA());
+            }
+            pendingInputs[c].push_back(inputs[c]);
+            pendingOutputs[c].push_back(expected[c]);
+        }
+
+        std::vector<int> outputs(CHANNELS);
+        for (size_t b = 0; b < banks.size(); b++)
+        {
+            SRL_forceKernel(kernels[b]);
+            banks[b]->processAll(inputs, &outputs[0]);
+            for (size_t c = 0; c < CHANNELS; c++)
+            {
+                if (outputs[c] != expected[c])
+                {
+                    fail(SRL_kernelName(kernels[b]), op, c, expected[c], outputs[c]);
+                }
+                if (banks[b]->getEMA(c) != reference[c].emaValue)
+                {
+                    fail(SRL_kernelName(kernels[b]), op, c, reference[c].emaValue, banks[b]->getEMA(c));
+                }
+            }
+        }
+
+        for (size_t c = 0; c < CHANNELS; c++)
+        {
+            activeSet.setInput(c, inputs[c]);
+        }
+        activeSet.tick();
+        for (size_t c = 0; c < CHANNELS; c++)
+        {
+            if (activeSet.getValue(c) != expected[c])
+            {
+                fail("active set", op, c, expected[c], activeSet.getValue(c));
+            }
+            if (activeSet.getEMA(c) != reference[c].emaValue)
+            {
+                fail("active set ema", op, c, reference[c].emaValue, activeSet.getEMA(c));
+            }
+        }
+
+#ifndef SRL_FUZZ_FULL_RANGE
+        std::vector<int16_t> inputs16(inputs, inputs + CHANNELS);
+        std::vector<int16_t> outputs16(CHANNELS);
+        for (size_t b = 0; b < banks16.size(); b++)
+        {
+            SRL_forceKernel(kernels[b]);
+            banks16[b]->processAll(&inputs16[0], &outputs16[0]);
+            for (size_t c = 0; c < CHANNELS; c++)
+            {
+                if (outputs16[c] != expected[c])
+                {
+                    fail("bank16", op, c, expected[c], outputs16[c]);
+                }
+                if (banks16[b]->getEMA(c) != reference[c].emaValue)
+                {
+                    fail("bank16 ema", op, c, reference[c].emaValue, banks16[b]->getEMA(c));
+                }
+            }
+        }
+#endif
+        SRL_forceKernel(SRL_KERNEL_AUTO);
+
+        for (size_t c = 0; c < CHANNELS; c++)
+        {
+            int output = 0;
+            if (op % 2 == 0)
+            {
+                groups[c]->processAll(&inputs[c], &output);
+            }
+            else
+            {
+                output = groups[c]->processValue(0, inputs[c]);
+            }
+            if (output != expected[c])
+            {
+                fail("group", op, c, expected[c], output);
+            }
+            if (groups[c]->getEMA(0) != reference[c].emaValue)
+            {
+                fail("group ema", op, c, reference[c].emaValue, groups[c]->getEMA(0));
+            }
+        }
+
+        tickClasses(op, inputs, &expected[0], read);
+    }
+
+    void tickClasses(size_t op, const int* inputs, const int* expected, bool read)
+    {
+        for (size_t c = 0; c < CHANNELS; c++)
+        {
+#ifndef SRL_FUZZ_FULL_RANGE
+            int output = fractional[c].processValue(inputs[c]);
+            if (output != expected[c])
+            {
+                fail("fractional", op, c, expected[c], output);
+            }
+            if (fractional[c].getEMA() != reference[c].emaValue)
+            {
+                fail("fractional ema", op, c, reference[c].emaValue, fractional[c].getEMA());
+            }
+#endif
+
+            // Written anywhere from the previous tick on (the first write starts the clock one period before
+            // this tick), and read at this tick
+            if (fresh[c] || inputs[c] != targets[c])
+            {
+                uint32_t offset = fresh[c] ? 0 : (uint32_t)((op * 2654435761UL + c) % LAZY_PERIOD);
+                lazy[c].setTarget(inputs[c], lazyClock - LAZY_PERIOD + offset);
+                schedulers[c]->setTarget(0, inputs[c]);
+                targets[c] = inputs[c];
+                fresh[c] = false;
+            }
+            schedulers[c]->tick();
+            if (read)
+            {
+                if (lazy[c].getValue(lazyClock) != expected[c])
+                {
+                    fail("lazy", op, c, expected[c], lazy[c].getValue(lazyClock));
+                }
+                if (lazy[c].getEMA(lazyClock) != reference[c].emaValue)
+                {
+                    fail("lazy ema", op, c, reference[c].emaValue, lazy[c].getEMA(lazyClock));
+                }
+            }
+
+            if (read)
+            {
+                if (schedulers[c]->getValue(0) != expected[c])
+                {
+                    fail("scheduler", op, c, expected[c], schedulers[c]->getValue(0));
+                }
+                if (schedulers[c]->getEMA(0) != reference[c].emaValue)
+                {
+                    fail("scheduler ema", op, c, reference[c].emaValue, schedulers[c]->getEMA(0));
+                }
+            }
+
+            StaticChannel* compiled[2] = { statics[c], consts[c] };
+            for (int k = 0; k < 2; k++)
+            {
+                if (compiled[k] == NULL)
+                {
+                    continue;
+                }
+                const char* what = (k == 0) ? "static" : "const";
+                int value = compiled[k]->processValue(inputs[c]);
+                if (value != expected[c])
+                {
+                    fail(what, op, c, expected[c], value);
+                }
+                if (compiled[k]->getEMA() != reference[c].emaValue)
+                {
+                    fail(what, op, c, reference[c].emaValue, compiled[k]->getEMA());
+                }
+            }
+        }
+        lazyClock += LAZY_PERIOD;
+    }
+
+    void set(size_t op, size_t c, int which, int32_t value)
+    {
+        flushBlock(op, c);
+#ifndef SRL_FUZZ_FULL_RANGE
+        if (which == 0 || which == 3)
+        {
+            value = (value < 0) ? -value - 1 : value;
+        }
+#endif
+        switch (which)
+        {
+            case 0:
+                reference[c].rateLimit = value;
+                single[c].setRateLimit(value);
+                block[c].setRateLimit(value);
+                for (size_t b = 0; b < banks.size(); b++) banks[b]->setRateLimit(c, value);
+                activeSet.setRateLimit(c, value);
+#ifndef SRL_FUZZ_FULL_RANGE
+                for (size_t b = 0; b < banks16.size(); b++) banks16[b]->setRateLimit(c, (int16_t)value);
+#endif
+                break;
+            case 1:
+                reference[c].hysteresisBand = value;
+                single[c].setHysteresisBand(value);
+                block[c].setHysteresisBand(value);
+                for (size_t b = 0; b < banks.size(); b++) banks[b]->setHysteresisBand(c, value);
+                activeSet.setHysteresisBand(c, value);
+#ifndef SRL_FUZZ_FULL_RANGE
+                for (size_t b = 0; b < banks16.size(); b++) banks16[b]->setHysteresisBand(c, (int16_t)value);
+#endif
+                break;
+            case 2:
+            {
+                SlewRateLimiter::SRL_SmoothingExponent exponent = (SlewRateLimiter::SRL_SmoothingExponent)((uint32_t)value % 10);
+                reference[c].exponent = exponent;
+                single[c].setSmoothingExponent(exponent);
+                block[c].setSmoothingExponent(exponent);
+                for (size_t b = 0; b < banks.size(); b++) banks[b]->setSmoothingExponent(c, exponent);
+                activeSet.setSmoothingExponent(c, exponent);
+#ifndef SRL_FUZZ_FULL_RANGE
+                for (size_t b = 0; b < banks16.size(); b++) banks16[b]->setSmoothingExponent(c, exponent);
+#endif
+                break;
+            }
+            default:
+            {
+#ifndef SRL_FUZZ_FULL_RANGE
+                value %= 1001;
+#endif
+                reference[c].adaptiveSlopeInternal = SRL_ReferenceLimiter::slopeToInternal(value);
+                slopes[c] = value;
+                single[c].setAdaptiveSlope(value);
+                block[c].setAdaptiveSlope(value);
+                for (size_t b = 0; b < banks.size(); b++) banks[b]->setAdaptiveSlope(c, value);
+                activeSet.setAdaptiveSlope(c, value);
+#ifndef SRL_FUZZ_FULL_RANGE
+                for (size_t b = 0; b < banks16.size(); b++) banks16[b]->setAdaptiveSlope(c, value);
+#endif
+                break;
+            }
+        }
+        rebuildGroup(c);
+        configureClasses(c, which == 2);
+    }
+
+    // Applies the configuration of reference[c] to the other limiter classes. The lazy limiter is evaluated up
+    // to the last tick first, as a setter applies from its last evaluated tick on.
+    void configureClasses(size_t c, bool exponentChanged)
+    {
+        SlewRateLimiter::SRL_SmoothingExponent exponent = (SlewRateLimiter::SRL_SmoothingExponent)reference[c].exponent;
+        int rate = reference[c].rateLimit;
+        int band = reference[c].hysteresisBand;
+#ifndef SRL_FUZZ_FULL_RANGE
+        fractional[c].setRateLimit(rate);
+        fractional[c].setHysteresisBand(band);
+        fractional[c].setSmoothingExponent(exponent);
+        fractional[c].setAdaptiveSlope(slopes[c]);
+#endif
+        if (!fresh[c])
+        {
+            lazy[c].getValue(lazyClock - LAZY_PERIOD);
+        }
+        lazy[c].setRateLimit(rate);
+        lazy[c].setHysteresisBand(band);
+        lazy[c].setSmoothingExponent(exponent);
+        lazy[c].setAdaptiveSlope(slopes[c]);
+        schedulers[c]->setRateLimit(0, rate);
+        schedulers[c]->setHysteresisBand(0, band);
+        schedulers[c]->setSmoothingExponent(0, exponent);
+        schedulers[c]->setAdaptiveSlope(0, slopes[c]);
+
+        // The exponent of StaticSlewRateLimiter, and everything in ConstSlewRateLimiter, is a template
+        // argument: they drop out until the channel is reset and they can be rebuilt
+        if (exponentChanged)
+        {
+            delete statics[c];
+            statics[c] = NULL;
+        }
+        if (statics[c] != NULL)
+        {
+            statics[c]->configure(rate, band, slopes[c]);
+        }
+        delete consts[c];
+        consts[c] = NULL;
+    }
+
+    void reset(size_t op, size_t c)
+    {
+        flushBlock(op, c);
+        reference[c].lastValue = 0;
+        reference[c].emaValue = 0;
+        reference[c].isFirstCall = true;
+        single[c].reset();
+        block[c].reset();
+        activeSet.reset(c);
+        groups[c]->reset(0);
+#ifndef SRL_FUZZ_FULL_RANGE
+        fractional[c].reset();
+#endif
+        lazy[c].reset();
+        fresh[c] = true;
+
+        // The scheduler has no per-channel reset: a fresh one takes the channel's configuration
+        SlewRateLimiter::SRL_SmoothingExponent exponent = (SlewRateLimiter::SRL_SmoothingExponent)reference[c].exponent;
+        delete schedulers[c];
+        schedulers[c] = new SlewRateLimiterScheduler(1, exponent, reference[c].rateLimit, reference[c].hysteresisBand,
+                                                     slopes[c], mode);
+        delete statics[c];
+        statics[c] = makeStatic(mode, exponent, reference[c].rateLimit, reference[c].hysteresisBand, slopes[c]);
+        delete consts[c];
+        bool defaults = exponent == SlewRateLimiter::SRL_SMOOTHING_4 && reference[c].rateLimit == 5
+                        && reference[c].hysteresisBand == 2 && slopes[c] == 0;
+        consts[c] = defaults ? makeConst(mode) : NULL;
+        for (size_t b = 0; b < banks.size(); b++)
+        {
+            banks[b]->reset(c);
+#ifndef SRL_FUZZ_FULL_RANGE
+            banks16[b]->reset(c);
+#endif
+        }
+    }
+
+    void finish(size_t op)
+    {
+        for (size_t c = 0; c < CHANNELS; c++)
+        {
+            flushBlock(op, c);
+        }
+    }
+};
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    Reader in = { data, size, 0 };
+    Harness harness((SlewRateLimiter::SRL_EMAMode)(in.byte() % 3));
+    int inputs[CHANNELS];
+
+    size_t op = 0;
+    for (; op < MAX_OPS && !in.done(); op++)
+    {
+        switch (in.byte() % 4)
+        {
+            case 0:
+                for (size_t c = 0; c < CHANNELS; c++)
+                {
+                    inputs[c] = in.value();
+                }
+                harness.tick(op, inputs, true);
+                break;
+            case 1:
+            {
+                size_t channel = in.byte() % CHANNELS;
+                int which = in.byte() % 4;
+                harness.set(op, channel, which, in.value());
+                break;
+            }
+            case 2:
+                harness.reset(op, in.byte() % CHANNELS);
+                break;
+            default:
+            {
+                int value = in.value();
+                for (size_t c = 0; c < CHANNELS; c++)
+                {
+                    inputs[c] = value;
+                }
+                for (int ticks = 1 + in.byte() % 16; ticks > 0; ticks--)
+                {
+                    harness.tick(op, inputs, false);
+                }
+                break;
+            }
+        }
+    }
+    harness.finish(op);
+    return 0;
+}
+
+#ifdef SRL_FUZZ_STANDALONE
+
+static int runFile(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file)
+    {
+        perror(path);
+        return 1;
+    }
+    std::vector<uint8_t> data;
+    uint8_t buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        data.insert(data.end(), buffer, buffer + n);
+    }
+    fclose(file);
+    LLVMFuzzerTestOneInput(data.empty() ? NULL : &data[0], data.size());
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc == 3 && strcmp(argv[1], "--random") == 0)
+    {
+        long count = atol(argv[2]);
+        uint32_t state = 1;
+        std::vector<uint8_t> data;
+        for (long i = 0; i < count; i++)
+        {
+            data.resize(64 + (state >> 16) % 4096);
+            for (size_t b = 0; b < data.size(); b++)
+            {
+                state = state * 1664525u + 1013904223u;
+                data[b] = (uint8_t)(state >> 24);
+            }
+            LLVMFuzzerTestOneInput(&data[0], data.size());
+        }
+        printf("srl_fuzz: %ld random inputs ok\n", count);
+        return 0;
+    }
+
+    int status = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        status |= runFile(argv[i]);
+    }
+    return status;
+}
+
+#endif /* SRL_FUZZ_STANDALONE */